@@ -0,0 +1,86 @@
+/*
+ * BatchPipeline.h
+ * ----------------------
+ * Definición de la clase plantilla BatchPipeline.
+ * Procesa muchos archivos de entrada en un pipeline de tres etapas (lectura,
+ * evaluación y formato de reporte) unidas por colas acotadas, de modo que el
+ * archivo k + 1 se lee mientras el archivo k se evalúa.
+ */
+
+#ifndef BATCHPIPELINE_H
+#define BATCHPIPELINE_H
+
+#include "EvaluationSystem.h"
+#include "BoundedQueue.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * Plantilla de clase BatchPipeline
+ * ----------------------------
+ * La lectura y la evaluación corren cada una en su propio hilo y el formato en
+ * el hilo que llama a run. Los reportes se escriben en el orden de los
+ * archivos, acumulados en un búfer. Un error en un archivo solo afecta a su
+ * reporte; el resto del lote continúa.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class BatchPipeline {
+public:
+    // Función que carga un archivo en un sistema de evaluación vacío
+    typedef std::function<void(const std::string&, EvaluationSystem<T>&)> Loader;
+
+    /*
+     * Constructor de la clase BatchPipeline
+     * ----------------------------------
+     * Parámetros:
+     *  - Loader loader: Carga cada archivo (texto, binario, etc.).
+     *  - size_t threads: Hilos de la evaluación de cada archivo (1 = secuencial, 0 = todos).
+     *  - size_t queueCapacity: Archivos que puede haber entre dos etapas.
+     */
+    BatchPipeline(Loader loader, std::size_t threads, std::size_t queueCapacity = 2);
+
+    /*
+     * Método para procesar un lote de archivos.
+     * ------------------------------------------------------------
+     * Escribe en out el reporte de cada archivo, precedido por su nombre.
+     * Retorna:
+     *  - Número de archivos que terminaron con error.
+     */
+    std::size_t run(const std::vector<std::string>& files, std::ostream& out);
+
+private:
+    // Archivo en tránsito por el pipeline
+    struct Job {
+        std::string fileName;
+        std::unique_ptr<EvaluationSystem<T>> system;
+        std::string error; // Vacío si todas las etapas anteriores terminaron bien
+    };
+
+    Loader loader;
+    std::size_t threads;
+    std::size_t queueCapacity;
+    std::shared_ptr<ThreadPool> pool; // Compartido por las evaluaciones en paralelo
+
+    void parseStage(const std::vector<std::string>& files, BoundedQueue<Job>& parsed);
+    void evaluateStage(BoundedQueue<Job>& parsed, BoundedQueue<Job>& evaluated);
+    std::size_t formatStage(BoundedQueue<Job>& evaluated, std::ostream& out);
+};
+
+/*
+ * Función para expandir las rutas de un lote.
+ * ------------------------------------------------------------
+ * Los directorios se reemplazan por sus archivos .in y .bin en orden
+ * alfabético; las demás rutas se conservan tal cual.
+ * Lanza std::runtime_error si un directorio no se puede abrir.
+ */
+std::vector<std::string> collectInputFiles(const std::vector<std::string>& paths);
+
+#include "BatchPipeline.hxx"
+
+#endif // BATCHPIPELINE_H
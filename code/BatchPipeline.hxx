@@ -0,0 +1,181 @@
+/*
+ * BatchPipeline.hxx
+ * ----------------------
+ * Implementación de la clase plantilla BatchPipeline.
+ */
+
+#ifndef BATCHPIPELINE_HXX
+#define BATCHPIPELINE_HXX
+
+#include "BatchPipeline.h"
+#include "Stats.h"
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BATCHPIPELINE_USE_DIRENT 1
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// Tamaño del búfer de salida antes de volcarlo al flujo
+const std::size_t BATCH_OUTPUT_FLUSH = 1 << 20;
+
+template <typename T>
+BatchPipeline<T>::BatchPipeline(Loader loader, std::size_t threads, std::size_t queueCapacity)
+    : loader(loader), threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads),
+      queueCapacity(queueCapacity)
+{
+    // El hilo de evaluación también trabaja, por eso el grupo tiene threads - 1 hilos
+    if (this->threads > 1)
+        pool = std::make_shared<ThreadPool>(this->threads - 1);
+}
+
+/*
+ * Implementación del método run
+ * ------------------------------
+ * Las colas se cierran al terminar cada etapa para que la siguiente sepa que
+ * no quedan archivos.
+ */
+template <typename T>
+std::size_t BatchPipeline<T>::run(const std::vector<std::string>& files, std::ostream& out)
+{
+    BoundedQueue<Job> parsed(queueCapacity);
+    BoundedQueue<Job> evaluated(queueCapacity);
+
+    std::thread parser([&]() { parseStage(files, parsed); });
+    std::thread evaluator([&]() { evaluateStage(parsed, evaluated); });
+    std::size_t failures = formatStage(evaluated, out);
+    parser.join();
+    evaluator.join();
+    return failures;
+}
+
+template <typename T>
+void BatchPipeline<T>::parseStage(const std::vector<std::string>& files, BoundedQueue<Job>& parsed)
+{
+    for (const std::string& fileName : files) {
+        Job job;
+        job.fileName = fileName;
+        try {
+            // Sistema con un solo hilo: la carga ordena su lote de forma secuencial
+            // mientras la etapa de evaluación ocupa los threads hilos configurados
+            job.system.reset(new EvaluationSystem<T>());
+            loader(fileName, *job.system);
+        } catch (const std::exception& e) {
+            job.system.reset();
+            job.error = e.what();
+        }
+        parsed.push(std::move(job));
+    }
+    parsed.close();
+}
+
+template <typename T>
+void BatchPipeline<T>::evaluateStage(BoundedQueue<Job>& parsed, BoundedQueue<Job>& evaluated)
+{
+    Job job;
+    while (parsed.pop(job)) {
+        if (job.error.empty()) {
+            try {
+                job.system->setThreadCount(threads);
+                job.system->pool = pool;
+                job.system->runEvaluation();
+            } catch (const std::exception& e) {
+                job.system.reset();
+                job.error = e.what();
+            }
+        }
+        evaluated.push(std::move(job));
+    }
+    evaluated.close();
+}
+
+/*
+ * Implementación del método formatStage
+ * --------------------------------------
+ * Cada reporte se arma completo antes de añadirlo al búfer, así un error a
+ * mitad del formato no deja salida parcial de ese archivo.
+ */
+template <typename T>
+std::size_t BatchPipeline<T>::formatStage(BoundedQueue<Job>& evaluated, std::ostream& out)
+{
+    std::size_t failures = 0;
+    std::string buffer;
+    Job job;
+    while (evaluated.pop(job)) {
+        STATS_TIMER(Output);
+        std::ostringstream report;
+        report << "Archivo: " << job.fileName << "\n";
+        if (job.error.empty()) {
+            try {
+                std::ostringstream body;
+                job.system->printResults(body);
+                job.system->printBestModels(body);
+                report << body.str();
+            } catch (const std::exception& e) {
+                job.error = e.what();
+            }
+        }
+        if (!job.error.empty()) {
+            report << "Error: " << job.error << "\n";
+            ++failures;
+        }
+        job.system.reset();
+
+        buffer += report.str();
+        if (buffer.size() >= BATCH_OUTPUT_FLUSH) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    return failures;
+}
+
+inline bool hasInputExtension(const std::string& name)
+{
+    const char* extensions[] = {".in", ".bin"};
+    for (const char* extension : extensions) {
+        std::string suffix(extension);
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            return true;
+    }
+    return false;
+}
+
+inline std::vector<std::string> collectInputFiles(const std::vector<std::string>& paths)
+{
+    std::vector<std::string> files;
+    for (const std::string& path : paths) {
+#ifdef BATCHPIPELINE_USE_DIRENT
+        struct stat info;
+        if (::stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+            DIR* directory = ::opendir(path.c_str());
+            if (!directory)
+                throw std::runtime_error("Error al abrir el directorio: " + path);
+            std::vector<std::string> entries;
+            while (struct dirent* entry = ::readdir(directory)) {
+                std::string name = entry->d_name;
+                std::string fullPath = path + "/" + name;
+                struct stat entryInfo;
+                if (hasInputExtension(name) && ::stat(fullPath.c_str(), &entryInfo) == 0 && S_ISREG(entryInfo.st_mode))
+                    entries.push_back(fullPath);
+            }
+            ::closedir(directory);
+            std::sort(entries.begin(), entries.end());
+            files.insert(files.end(), entries.begin(), entries.end());
+            continue;
+        }
+#endif
+        files.push_back(path);
+    }
+    return files;
+}
+
+#endif // BATCHPIPELINE_HXX
@@ -0,0 +1,98 @@
+/*
+ * BinaryDataFile.h
+ * ----------------------
+ * Formato binario por columnas para conjuntos de datos y modelos.
+ * Guarda las columnas x/y ya ordenadas, las pendientes y ordenadas de los
+ * modelos, el tipo de elemento T y una suma de verificación, de modo que el
+ * archivo se pueda proyectar en memoria y evaluar sin copiar ni analizar texto.
+ */
+
+#ifndef BINARYDATAFILE_H
+#define BINARYDATAFILE_H
+
+#include "EvaluationSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ * Estructura BinaryFileHeader
+ * ----------------------------
+ * Cabecera de 128 bytes al inicio del archivo. Los desplazamientos son desde
+ * el inicio del archivo y están alineados a BINARY_FILE_ALIGNMENT bytes.
+ * La suma de verificación cubre la cabecera (con el campo checksum en cero) y
+ * todos los bytes posteriores a ella.
+ */
+struct BinaryFileHeader {
+    char magic[8];            // "LRCOLS\0\0"
+    std::uint32_t version;    // Versión del formato
+    std::uint32_t endianTag;  // 0x01020304 escrito con el orden de bytes nativo
+    std::uint32_t typeCode;   // Código del tipo T (ver BinaryTypeCode)
+    std::uint32_t elementSize;
+    std::uint64_t pointCount;
+    std::uint64_t modelCount;
+    std::uint64_t xOffset;
+    std::uint64_t yOffset;
+    std::uint64_t slopeOffset;
+    std::uint64_t interceptOffset;
+    std::uint64_t fileSize;
+    std::uint64_t checksum;
+    std::uint8_t reserved[40];
+};
+
+const std::uint32_t BINARY_FILE_VERSION = 2; // 2: la suma de verificación incluye la cabecera
+const std::uint32_t BINARY_FILE_ENDIAN_TAG = 0x01020304;
+const std::size_t BINARY_FILE_ALIGNMENT = 64;
+
+/*
+ * Plantilla BinaryTypeCode
+ * ----------------------------
+ * Asocia a cada tipo de elemento soportado un código estable en el archivo.
+ */
+template <typename T>
+struct BinaryTypeCode;
+
+template <> struct BinaryTypeCode<std::int16_t> { static const std::uint32_t value = 1; };
+template <> struct BinaryTypeCode<std::int32_t> { static const std::uint32_t value = 2; };
+template <> struct BinaryTypeCode<float> { static const std::uint32_t value = 3; };
+template <> struct BinaryTypeCode<double> { static const std::uint32_t value = 4; };
+
+/*
+ * Función isBinaryDataFile
+ * ----------------------------
+ * Indica si el archivo comienza con la firma del formato binario.
+ */
+bool isBinaryDataFile(const std::string& fileName);
+
+/*
+ * Función binaryDataFileTypeCode
+ * ----------------------------
+ * Código del tipo de elemento guardado en la cabecera (ver BinaryTypeCode), o
+ * 0 si el archivo no es binario. Permite elegir T antes de cargar el archivo.
+ */
+std::uint32_t binaryDataFileTypeCode(const std::string& fileName);
+
+/*
+ * Función writeBinaryDataFile
+ * ----------------------------
+ * Escribe los puntos (ya ordenados) y los modelos del conjunto en formato binario.
+ * Lanza std::runtime_error si no se puede escribir el archivo.
+ */
+template <typename T>
+void writeBinaryDataFile(const std::string& fileName, const DataSet<T>& dataSet);
+
+/*
+ * Función loadBinaryDataFile
+ * ----------------------------
+ * Proyecta el archivo en memoria, valida la cabecera (firma, versión, tipo,
+ * tamaños y, opcionalmente, la suma de verificación y el orden de x) y asocia
+ * las columnas al conjunto del sistema sin copiarlas. Los modelos se agregan
+ * con addModel.
+ * Lanza std::runtime_error si el archivo no es válido.
+ */
+template <typename T>
+void loadBinaryDataFile(const std::string& fileName, EvaluationSystem<T>& system, bool verifyChecksum = true);
+
+#include "BinaryDataFile.hxx"
+
+#endif // BINARYDATAFILE_H
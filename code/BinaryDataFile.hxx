@@ -0,0 +1,227 @@
+/*
+ * BinaryDataFile.hxx
+ * ----------------------
+ * Implementación de la escritura y la carga del formato binario por columnas.
+ */
+
+#ifndef BINARYDATAFILE_HXX
+#define BINARYDATAFILE_HXX
+
+#include "BinaryDataFile.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+static_assert(sizeof(BinaryFileHeader) == 128, "La cabecera binaria debe ocupar 128 bytes");
+
+const char BINARY_FILE_MAGIC[8] = {'L', 'R', 'C', 'O', 'L', 'S', '\0', '\0'};
+
+/*
+ * Función binaryChecksum
+ * ----------------------------
+ * FNV-1a aplicado a palabras de 64 bits (y byte a byte en la cola), con una
+ * mezcla xor-desplazamiento por paso para difundir los bits altos.
+ */
+inline std::uint64_t binaryChecksum(const char* bytes, std::size_t length, std::uint64_t hash = 14695981039346656037ULL)
+{
+    const std::uint64_t prime = 1099511628211ULL;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; ++i)
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * prime;
+    return hash;
+}
+
+/*
+ * Función binaryFileChecksum
+ * ----------------------------
+ * Suma de verificación del archivo completo: la cabecera con el campo
+ * checksum en cero y luego el resto de los bytes.
+ */
+inline std::uint64_t binaryFileChecksum(const char* bytes, std::size_t length)
+{
+    BinaryFileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    header.checksum = 0;
+    std::uint64_t hash = binaryChecksum(reinterpret_cast<const char*>(&header), sizeof(header));
+    return binaryChecksum(bytes + sizeof(header), length - sizeof(header), hash);
+}
+
+// Indica si count elementos de elementSize bytes desde offset terminan a más tardar en end, sin desbordar
+inline bool binarySectionFits(std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize, std::uint64_t end)
+{
+    return offset <= end && count <= (end - offset) / elementSize;
+}
+
+// Redondea un desplazamiento hacia arriba al múltiplo de BINARY_FILE_ALIGNMENT
+inline std::uint64_t alignBinaryOffset(std::uint64_t offset)
+{
+    return (offset + BINARY_FILE_ALIGNMENT - 1) / BINARY_FILE_ALIGNMENT * BINARY_FILE_ALIGNMENT;
+}
+
+inline bool isBinaryDataFile(const std::string& fileName)
+{
+    std::ifstream input(fileName, std::ios::binary);
+    char magic[sizeof(BINARY_FILE_MAGIC)];
+    if (!input.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, BINARY_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+inline std::uint32_t binaryDataFileTypeCode(const std::string& fileName)
+{
+    std::ifstream input(fileName, std::ios::binary);
+    BinaryFileHeader header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, BINARY_FILE_MAGIC, sizeof(header.magic)) != 0)
+        return 0;
+    return header.typeCode;
+}
+
+// Escribe ceros hasta que la posición del flujo alcance el desplazamiento dado
+inline void padBinaryOutput(std::ofstream& output, std::uint64_t offset)
+{
+    static const char zeros[BINARY_FILE_ALIGNMENT] = {};
+    std::uint64_t position = static_cast<std::uint64_t>(output.tellp());
+    if (position < offset)
+        output.write(zeros, static_cast<std::streamsize>(offset - position));
+}
+
+/*
+ * Implementación de writeBinaryDataFile
+ * --------------------------------------
+ * Escribe la cabecera y cada sección en su desplazamiento alineado sin armar
+ * el archivo en memoria. Luego proyecta el archivo escrito para calcular la
+ * suma de verificación y reescribe la cabecera con ella.
+ */
+template <typename T>
+void writeBinaryDataFile(const std::string& fileName, const DataSet<T>& dataSet)
+{
+    if (dataSet.batchOpen)
+        throw std::logic_error("No se puede escribir un conjunto con una carga por lotes abierta");
+
+    const std::uint64_t N = dataSet.pointCount();
+    const std::uint64_t P = dataSet.modelBank.size();
+
+    BinaryFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_FILE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_FILE_VERSION;
+    header.endianTag = BINARY_FILE_ENDIAN_TAG;
+    header.typeCode = BinaryTypeCode<T>::value;
+    header.elementSize = sizeof(T);
+    header.pointCount = N;
+    header.modelCount = P;
+    header.xOffset = alignBinaryOffset(sizeof(BinaryFileHeader));
+    header.yOffset = alignBinaryOffset(header.xOffset + N * sizeof(T));
+    header.slopeOffset = alignBinaryOffset(header.yOffset + N * sizeof(T));
+    header.interceptOffset = alignBinaryOffset(header.slopeOffset + P * sizeof(double));
+    header.fileSize = header.interceptOffset + P * sizeof(double);
+
+    const std::vector<double>& slopes = dataSet.modelBank.slopes;
+    const std::vector<double>& intercepts = dataSet.modelBank.intercepts;
+
+    {
+        std::ofstream output(fileName, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+            throw std::runtime_error("Error al crear el archivo: " + fileName);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        padBinaryOutput(output, header.xOffset);
+        output.write(reinterpret_cast<const char*>(dataSet.xData()), static_cast<std::streamsize>(N * sizeof(T)));
+        padBinaryOutput(output, header.yOffset);
+        output.write(reinterpret_cast<const char*>(dataSet.yData()), static_cast<std::streamsize>(N * sizeof(T)));
+        padBinaryOutput(output, header.slopeOffset);
+        output.write(reinterpret_cast<const char*>(slopes.data()), static_cast<std::streamsize>(P * sizeof(double)));
+        padBinaryOutput(output, header.interceptOffset);
+        output.write(reinterpret_cast<const char*>(intercepts.data()), static_cast<std::streamsize>(P * sizeof(double)));
+        if (!output)
+            throw std::runtime_error("Error al escribir el archivo: " + fileName);
+    }
+
+    {
+        MappedFile written(fileName);
+        header.checksum = binaryFileChecksum(written.data(), written.size());
+    }
+    std::fstream output(fileName, std::ios::binary | std::ios::in | std::ios::out);
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!output)
+        throw std::runtime_error("Error al escribir el archivo: " + fileName);
+}
+
+/*
+ * Implementación de loadBinaryDataFile
+ * -------------------------------------
+ * Valida la cabecera contra el tipo T y el tamaño real del archivo; las
+ * columnas quedan proyectadas y compartidas con el conjunto de datos. Las
+ * secciones se comprueban restando desplazamientos ya ordenados en lugar de
+ * sumar N·sizeof(T), que podría desbordar con una cabecera corrupta; así la
+ * validación protege aunque no se verifique la suma.
+ * Con la verificación activa también se comprueba que x no decrezca: la
+ * inserción, las consultas por rango y el índice de momentos lo suponen, y
+ * un archivo editado a mano o de otro origen podría no cumplirlo.
+ */
+template <typename T>
+void loadBinaryDataFile(const std::string& fileName, EvaluationSystem<T>& system, bool verifyChecksum)
+{
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(fileName);
+    if (file->size() < sizeof(BinaryFileHeader))
+        throw std::runtime_error(fileName + ": archivo binario truncado");
+
+    BinaryFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, BINARY_FILE_MAGIC, sizeof(header.magic)) != 0)
+        throw std::runtime_error(fileName + ": no es un archivo binario de datos");
+    if (header.version != BINARY_FILE_VERSION)
+        throw std::runtime_error(fileName + ": versión de formato no soportada " + std::to_string(header.version));
+    if (header.endianTag != BINARY_FILE_ENDIAN_TAG)
+        throw std::runtime_error(fileName + ": orden de bytes distinto al de esta máquina");
+    if (header.typeCode != BinaryTypeCode<T>::value || header.elementSize != sizeof(T))
+        throw std::runtime_error(fileName + ": el tipo de elemento del archivo no coincide con el del conjunto");
+
+    const std::uint64_t N = header.pointCount;
+    const std::uint64_t P = header.modelCount;
+    if (header.fileSize != file->size() ||
+        header.xOffset < sizeof(BinaryFileHeader) ||
+        !binarySectionFits(header.xOffset, N, sizeof(T), header.yOffset) ||
+        !binarySectionFits(header.yOffset, N, sizeof(T), header.slopeOffset) ||
+        !binarySectionFits(header.slopeOffset, P, sizeof(double), header.interceptOffset) ||
+        !binarySectionFits(header.interceptOffset, P, sizeof(double), header.fileSize) ||
+        header.xOffset % BINARY_FILE_ALIGNMENT != 0 || header.yOffset % BINARY_FILE_ALIGNMENT != 0 ||
+        header.slopeOffset % BINARY_FILE_ALIGNMENT != 0 || header.interceptOffset % BINARY_FILE_ALIGNMENT != 0)
+        throw std::runtime_error(fileName + ": cabecera binaria inconsistente con el tamaño del archivo");
+    if (N == 0)
+        throw std::runtime_error("El número de puntos debe ser mayor que cero.");
+    if (P == 0)
+        throw std::runtime_error("El número de modelos debe ser mayor que cero.");
+
+    if (verifyChecksum && binaryFileChecksum(file->data(), file->size()) != header.checksum)
+        throw std::runtime_error(fileName + ": la suma de verificación no coincide");
+
+    const T* xs = reinterpret_cast<const T*>(file->data() + header.xOffset);
+    const T* ys = reinterpret_cast<const T*>(file->data() + header.yOffset);
+    if (verifyChecksum) {
+        // La comparación negada también rechaza NaN, que no tiene lugar en el orden
+        for (std::uint64_t i = 1; i < N; ++i) {
+            if (!(xs[i - 1] <= xs[i]))
+                throw std::runtime_error(fileName + ": la columna x no está ordenada (posición " +
+                                         std::to_string(i) + ")");
+        }
+    }
+    system.dataSet.attachColumns(file, xs, ys, static_cast<std::size_t>(N));
+
+    const double* slopes = reinterpret_cast<const double*>(file->data() + header.slopeOffset);
+    const double* intercepts = reinterpret_cast<const double*>(file->data() + header.interceptOffset);
+    for (std::uint64_t k = 0; k < P; ++k)
+        system.addModel(slopes[k], intercepts[k]);
+}
+
+#endif // BINARYDATAFILE_HXX
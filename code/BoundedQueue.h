@@ -0,0 +1,58 @@
+/*
+ * BoundedQueue.h
+ * ----------------------
+ * Definición de la clase plantilla BoundedQueue.
+ * Cola FIFO de capacidad fija para comunicar etapas de un pipeline: push
+ * espera mientras la cola está llena y pop espera mientras está vacía.
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/*
+ * Plantilla de clase BoundedQueue
+ * ----------------------------
+ * El productor llama a close() al terminar; desde entonces pop vacía lo que
+ * queda y luego retorna false.
+ * T es el tipo de los elementos; debe poder moverse.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /*
+     * Constructor de la clase BoundedQueue
+     * ----------------------------------
+     * Parámetros:
+     *  - size_t capacity: Elementos que caben antes de bloquear al productor (mínimo 1).
+     */
+    explicit BoundedQueue(std::size_t capacity);
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Añade un elemento; espera si la cola está llena
+    void push(T item);
+
+    // Extrae el elemento más antiguo; retorna false si la cola está cerrada y vacía
+    bool pop(T& item);
+
+    // Indica que no se añadirán más elementos
+    void close();
+
+private:
+    std::size_t capacity;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    bool closed = false;
+};
+
+#include "BoundedQueue.hxx"
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,54 @@
+/*
+ * BoundedQueue.hxx
+ * ----------------------
+ * Implementación de la clase plantilla BoundedQueue.
+ */
+
+#ifndef BOUNDEDQUEUE_HXX
+#define BOUNDEDQUEUE_HXX
+
+#include "BoundedQueue.h"
+#include <stdexcept>
+#include <utility>
+
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+template <typename T>
+void BoundedQueue<T>::push(T item)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this]() { return items.size() < capacity || closed; });
+    if (closed)
+        throw std::logic_error("No se puede añadir a una cola cerrada");
+    items.push_back(std::move(item));
+    lock.unlock();
+    notEmpty.notify_one();
+}
+
+template <typename T>
+bool BoundedQueue<T>::pop(T& item)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]() { return !items.empty() || closed; });
+    if (items.empty())
+        return false;
+    item = std::move(items.front());
+    items.pop_front();
+    lock.unlock();
+    notFull.notify_one();
+    return true;
+}
+
+template <typename T>
+void BoundedQueue<T>::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+}
+
+#endif // BOUNDEDQUEUE_HXX
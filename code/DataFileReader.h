@@ -0,0 +1,71 @@
+/*
+ * DataFileReader.h
+ * ----------------------
+ * Definición de la clase DataFileReader.
+ * Lector del formato de entrada .in (N, N puntos, P, P modelos) que proyecta
+ * el archivo en memoria y convierte los números con un analizador propio,
+ * sin asignaciones por token y sin depender de la configuración regional.
+ */
+
+#ifndef DATAFILEREADER_H
+#define DATAFILEREADER_H
+
+#include "EvaluationSystem.h"
+#include "MappedFile.h"
+#include <string>
+
+/*
+ * Clase DataFileReader
+ * ----------------------------
+ * Recorre el archivo una sola vez y entrega los puntos y modelos al sistema de
+ * evaluación. Los errores de formato se informan con línea y columna.
+ */
+class DataFileReader {
+public:
+    /*
+     * Constructor de la clase DataFileReader
+     * ----------------------------------
+     * Parámetros:
+     *  - string fileName: Ruta del archivo .in a leer.
+     */
+    explicit DataFileReader(const std::string& fileName);
+
+    /*
+     * Método para cargar el contenido del archivo en un sistema de evaluación.
+     * ------------------------------------------------------------
+     * Los puntos se agregan mediante una carga por lotes del conjunto de datos.
+     * Lanza std::runtime_error si N o P no coinciden con el contenido.
+     */
+    template <typename T>
+    void load(EvaluationSystem<T>& system);
+
+private:
+    MappedFile file;
+    const char* cursor; // Posición actual de lectura
+    const char* end;    // Fin del archivo
+    bool crossedLine = false; // true si el último skipWhitespace pasó por un salto de línea
+    std::string hint;         // Pista que se añade a los errores posteriores (N inconsistente)
+
+    // Avanza sobre espacios y saltos de línea; retorna false si se llegó al final
+    bool skipWhitespace();
+
+    // Lee el siguiente número real; retorna false si no quedan tokens
+    bool readNumber(double& value);
+
+    // Lee un entero no negativo que indica una cantidad (N o P)
+    long long readCount(const std::string& what);
+
+    // Convierte una coordenada leída al tipo de los puntos; con T entero exige un entero representable
+    template <typename T>
+    T pointValue(double value) const;
+
+    // Verifica que no quede contenido tras el último modelo
+    void expectEnd(long long P);
+
+    // Lanza una excepción con la línea y la columna de la posición dada
+    [[noreturn]] void fail(const char* position, const std::string& message) const;
+};
+
+#include "DataFileReader.hxx"
+
+#endif // DATAFILEREADER_H
@@ -0,0 +1,284 @@
+/*
+ * DataFileReader.hxx
+ * ----------------------
+ * Implementación de la clase DataFileReader.
+ * Aquí se define el analizador de números y la lectura del formato .in.
+ */
+
+#ifndef DATAFILEREADER_HXX
+#define DATAFILEREADER_HXX
+
+#include "DataFileReader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+// Menor número de bytes que ocupa un punto en el archivo ("x y" y un separador)
+const std::size_t MIN_POINT_BYTES = 4;
+
+/*
+ * Función parseDecimal
+ * ----------------------------
+ * Convierte el token [begin, end) a double. Si la mantisa tiene a lo sumo 19
+ * dígitos, cabe en 53 bits y el exponente decimal está en [-22, 22], el
+ * resultado m·10^e es exacto con una sola operación (ruta rápida de Clinger).
+ * En otro caso se recurre a strtod sobre una copia en la pila.
+ * Retorna false si el token no es un número válido.
+ */
+inline bool parseDecimal(const char* begin, const char* end, double& value)
+{
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+    bool exact = true;
+
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        anyDigit = true;
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            if (mantissa != 0)
+                ++significantDigits;
+        } else {
+            ++exponent;
+            exact = false;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+            anyDigit = true;
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                if (mantissa != 0)
+                    ++significantDigits;
+                --exponent;
+            } else {
+                exact = false;
+            }
+        }
+    }
+    if (!anyDigit)
+        return false;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9')
+            return false;
+        int explicitExponent = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+            if (explicitExponent < 100000)
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != end)
+        return false;
+
+    if (exact && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // Ruta lenta: tokens muy largos o exponentes fuera del rango exacto
+    char token[128];
+    std::size_t length = static_cast<std::size_t>(end - begin);
+    if (length >= sizeof(token))
+        return false;
+    std::memcpy(token, begin, length);
+    token[length] = '\0';
+    value = std::strtod(token, nullptr);
+    return true;
+}
+
+/*
+ * Constructor de DataFileReader
+ * -----------------------------
+ * Proyecta el archivo en memoria y sitúa el cursor al inicio.
+ */
+inline DataFileReader::DataFileReader(const std::string& fileName)
+    : file(fileName), cursor(file.data()), end(file.data() + file.size()) {}
+
+/*
+ * Implementación del método skipWhitespace
+ * -----------------------------------------
+ * Omite espacios, tabulaciones y saltos de línea (incluido \r).
+ */
+inline bool DataFileReader::skipWhitespace()
+{
+    crossedLine = false;
+    while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\t' || *cursor == '\r')) {
+        if (*cursor == '\n')
+            crossedLine = true;
+        ++cursor;
+    }
+    return cursor < end;
+}
+
+/*
+ * Implementación del método readNumber
+ * -------------------------------------
+ * Delimita el siguiente token y lo convierte con parseDecimal.
+ */
+inline bool DataFileReader::readNumber(double& value)
+{
+    if (!skipWhitespace())
+        return false;
+    const char* tokenStart = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\n' && *cursor != '\t' && *cursor != '\r')
+        ++cursor;
+    if (!parseDecimal(tokenStart, cursor, value))
+        fail(tokenStart, "valor numérico inválido '" + std::string(tokenStart, cursor) + "'");
+    return true;
+}
+
+/*
+ * Implementación del método readCount
+ * ------------------------------------
+ * Lee un entero con signo opcional; rechaza decimales y valores fuera de rango.
+ */
+inline long long DataFileReader::readCount(const std::string& what)
+{
+    if (!skipWhitespace())
+        fail(cursor, "se esperaba " + what + " pero el archivo terminó");
+    const char* tokenStart = cursor;
+    bool negative = false;
+    if (*cursor == '+' || *cursor == '-') {
+        negative = (*cursor == '-');
+        ++cursor;
+    }
+    long long count = 0;
+    bool anyDigit = false;
+    for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor) {
+        anyDigit = true;
+        if (count > 1000000000000000LL)
+            fail(tokenStart, what + " fuera de rango");
+        count = count * 10 + (*cursor - '0');
+    }
+    if (!anyDigit || (cursor < end && *cursor != ' ' && *cursor != '\n' && *cursor != '\t' && *cursor != '\r')) {
+        while (cursor < end && *cursor != ' ' && *cursor != '\n' && *cursor != '\t' && *cursor != '\r')
+            ++cursor;
+        fail(tokenStart, "se esperaba " + what + " (entero) pero se encontró '" +
+                         std::string(tokenStart, cursor) + "'; ¿el número de puntos N no coincide con el contenido?");
+    }
+    return negative ? -count : count;
+}
+
+/*
+ * Implementación del método expectEnd
+ * ------------------------------------
+ * Tras los P modelos solo pueden quedar espacios.
+ */
+inline void DataFileReader::expectEnd(long long P)
+{
+    if (skipWhitespace())
+        fail(cursor, "contenido adicional tras los " + std::to_string(P) +
+                     " modelos; ¿el número de modelos P no coincide con el contenido?");
+}
+
+/*
+ * Implementación del método fail
+ * -------------------------------
+ * Calcula la línea y la columna (desde 1) de la posición solo cuando hay un
+ * error, para no penalizar la lectura normal. Añade la pista registrada, si existe.
+ */
+inline void DataFileReader::fail(const char* position, const std::string& message) const
+{
+    std::size_t line = 1;
+    const char* lineStart = file.data();
+    for (const char* p = file.data(); p < position; ++p) {
+        if (*p == '\n') {
+            ++line;
+            lineStart = p + 1;
+        }
+    }
+    std::size_t column = static_cast<std::size_t>(position - lineStart) + 1;
+    throw std::runtime_error(file.name() + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message +
+                             (hint.empty() ? "" : " (" + hint + ")"));
+}
+
+template <typename T>
+T DataFileReader::pointValue(double value) const
+{
+    if constexpr (std::is_integral_v<T>) {
+        if (!(value >= static_cast<double>(std::numeric_limits<T>::min()) &&
+              value <= static_cast<double>(std::numeric_limits<T>::max())) || value != std::nearbyint(value)) {
+            std::ostringstream text;
+            text << "el valor " << value << " no es un entero representable en el tipo de los puntos";
+            fail(cursor, text.str());
+        }
+    }
+    return static_cast<T>(value);
+}
+
+/*
+ * Implementación del método load
+ * -------------------------------
+ * Lee N, los N puntos (en una carga por lotes), P y los P modelos, y verifica
+ * que el archivo no tenga contenido de más. Si algún punto tiene sus dos
+ * coordenadas en líneas distintas, se recuerda como pista de que N no coincide.
+ */
+template <typename T>
+void DataFileReader::load(EvaluationSystem<T>& system)
+{
+    const char* countStart = cursor;
+    long long N = readCount("el número de puntos N");
+    if (N <= 0)
+        fail(countStart, "El número de puntos debe ser mayor que cero.");
+
+    // Se reserva a lo sumo lo que cabe en el archivo: un N corrupto no debe
+    // agotar la memoria antes de que la lectura informe dónde faltan puntos
+    const std::size_t fitting = static_cast<std::size_t>(end - cursor) / MIN_POINT_BYTES + 1;
+    system.beginBatch(std::min(static_cast<std::size_t>(N), fitting));
+    for (long long i = 0; i < N; i++) {
+        double x, y;
+        if (!readNumber(x) || !readNumber(y))
+            fail(cursor, "se esperaban " + std::to_string(N) + " puntos pero el archivo terminó en el punto " +
+                         std::to_string(i + 1));
+        if (crossedLine && hint.empty())
+            hint = "el punto " + std::to_string(i + 1) + " de N = " + std::to_string(N) +
+                   " tiene sus coordenadas en líneas distintas; ¿N no coincide con el número de puntos?";
+        system.addDataPoint(pointValue<T>(x), pointValue<T>(y));
+    }
+    system.commitBatch();
+
+    skipWhitespace();
+    countStart = cursor;
+    long long P = readCount("el número de modelos P");
+    if (P <= 0)
+        fail(countStart, "El número de modelos debe ser mayor que cero.");
+
+    for (long long i = 0; i < P; i++) {
+        double M, B;
+        if (!readNumber(M) || !readNumber(B))
+            fail(cursor, "se esperaban " + std::to_string(P) + " modelos pero el archivo terminó en el modelo " +
+                         std::to_string(i + 1));
+        system.addModel(M, B);
+    }
+    expectEnd(P);
+}
+
+#endif // DATAFILEREADER_HXX
@@ -11,8 +11,21 @@
 
 #include "LinearRegression.h"
 #include "DataPoint.h"
+#include "MomentIndex.h"
+#include "ModelBank.h"
+#include "MappedFile.h"
+#include "StreamingMetrics.h"
+#include "SuccessiveHalving.h"
+#include "RegressionFitter.h"
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <list>
+#include <memory>
+#include <vector>
+
+// Inserciones individuales que se acumulan antes de sumarlas a las estadísticas
+const std::uint64_t INSERT_REPORT_INTERVAL = 4096;
 
 /*
  * Plantilla de clase DataSet
@@ -27,10 +40,47 @@ public:
      * Atributos de la clase:
      * ----------------------
      * dataPoints - Estructura lineal que almacena los puntos de datos.
-     * models - Estructura lineal que almacena los modelos de regresión lineal asociados.
+     * xColumn, yColumn - Columnas contiguas (estructura de arreglos) con las mismas
+     *                    coordenadas de dataPoints y en el mismo orden; las usa el
+     *                    núcleo de evaluación fusionado.
+     * modelBank - Almacenamiento contiguo y único dueño de los modelos: coeficientes y
+     *             métricas. La lista de modelos se construye desde él con models().
+     * columnHead - Posición en xColumn/yColumn del primer punto vigente; los puntos
+     *              expulsados por la ventana deslizante se descartan al compactar.
+     * momentIndex - Índice de momentos por bloques sobre los puntos ordenados;
+     *               se invalida al insertar y se reconstruye cuando se necesita.
+     * pendingPoints - Puntos añadidos durante una carga por lotes, aún sin ordenar.
+     * batchOpen - Indica si hay una carga por lotes abierta (beginBatch sin commitBatch).
+     * sortThreads - Hilos que commitBatch puede usar para ordenar el lote.
+     * unreportedInserts, unreportedShifts - Inserciones individuales y desplazamientos
+     *               aún no sumados a las estadísticas (solo con CODE_STATS).
+     * mappedStorage, mappedX, mappedY, mappedCount - Columnas externas proyectadas en
+     *               memoria (archivo binario). Mientras existan, el conjunto las usa
+     *               directamente sin copiarlas y dataPoints queda vacío.
+     * streaming - Indica si el modo de flujo continuo está activo.
+     * streamingMetrics - Sumas de errores por modelo que se actualizan en cada inserción.
+     * windowMaxPoints - Máximo de puntos de la ventana deslizante (0 = sin límite).
+     * windowHorizon - Amplitud máxima en x de la ventana deslizante (0 = sin límite).
      */
     std::deque<DataPoint<T>> dataPoints;
-    std::list<LinearRegression<T>> models;
+    ModelBank<T> modelBank;
+    std::vector<T> xColumn;
+    std::vector<T> yColumn;
+    std::size_t columnHead = 0;
+    MomentIndex<T> momentIndex;
+    std::vector<DataPoint<T>> pendingPoints;
+    bool batchOpen = false;
+    std::size_t sortThreads = 1;
+    std::uint64_t unreportedInserts = 0;
+    std::uint64_t unreportedShifts = 0;
+    std::shared_ptr<const MappedFile> mappedStorage;
+    const T* mappedX = nullptr;
+    const T* mappedY = nullptr;
+    std::size_t mappedCount = 0;
+    bool streaming = false;
+    StreamingMetrics<T> streamingMetrics;
+    std::size_t windowMaxPoints = 0;
+    double windowHorizon = 0.0;
 
     /*
      * Método para añadir un punto de datos al conjunto.
@@ -41,6 +91,29 @@ public:
      */
     void addDataPoint(T x, T y);
 
+    /*
+     * Método para añadir un rango de puntos de datos de una sola vez.
+     * ------------------------------------------------------------
+     * Los puntos se agregan sin orden, se ordenan una vez y se mezclan con los
+     * existentes: O(N log N) en lugar de O(N²) con inserciones individuales.
+     * Parámetros:
+     *  - InputIt first, InputIt last: Rango de DataPoint<T>.
+     */
+    template <typename InputIt>
+    void addDataPoints(InputIt first, InputIt last);
+
+    /*
+     * Métodos para la carga por lotes.
+     * ------------------------------------------------------------
+     * Entre beginBatch y commitBatch, addDataPoint solo agrega el punto al lote
+     * pendiente. commitBatch ordena el lote (con hasta sortThreads hilos si es grande), lo mezcla
+     * con los puntos existentes y restablece el orden por x.
+     * Parámetros:
+     *  - size_t expectedPoints: Número de puntos esperado, para reservar memoria.
+     */
+    void beginBatch(std::size_t expectedPoints = 0);
+    void commitBatch();
+
     /*
      * Método para añadir un modelo de regresión lineal al conjunto.
      * ------------------------------------------------------------
@@ -50,6 +123,15 @@ public:
      */
     void addModel(double slope, double intercept);
 
+    /*
+     * Método para añadir un modelo ya construido, conservando sus métricas.
+     * ------------------------------------------------------------
+     * Pensado para los modelos de RegressionFitter, que llegan evaluados.
+     * Parámetros:
+     *  - LinearRegression<T> model: Modelo a añadir.
+     */
+    void addModel(const LinearRegression<T>& model);
+
     /*
      * Método para evaluar todos los modelos de regresión asociados.
      * ------------------------------------------------------------
@@ -66,6 +148,168 @@ public:
      *  - Modelo de regresión lineal con el mejor ajuste.
      */
     LinearRegression<T> findBestModel(const std::string& metric);
+
+    /*
+     * Método para encontrar los k mejores modelos según una métrica.
+     * ------------------------------------------------------------
+     * La métrica se elige en tiempo de compilación, por ejemplo findTopK<Metric::MSE>(10).
+     * Retorna:
+     *  - Posiciones de los modelos en modelBank, del mejor al peor.
+     */
+    template <Metric M>
+    std::vector<std::size_t> findTopK(std::size_t k);
+
+    /*
+     * Método para encontrar el mejor modelo de cada métrica en una sola pasada.
+     * ------------------------------------------------------------
+     * Retorna:
+     *  - Posiciones del mejor modelo según MAE, MSE y RMSE (NO_MODEL si la
+     *    métrica no está calculada en todos los modelos).
+     */
+    BestModelIndices findBestModels();
+
+    /*
+     * Método para encontrar el mejor modelo sin evaluar todos los modelos en todos los puntos.
+     * ------------------------------------------------------------
+     * Eliminación sucesiva sobre muestras crecientes (ver SuccessiveHalving).
+     * Parámetros:
+     *  - string metric: "MAE", "MSE" o "RMSE".
+     *  - HalvingOptions options: Tolerancia, confianza y tamaños de muestra.
+     *  - ThreadPool* pool: Grupo de hilos opcional para estimar en paralelo.
+     * Retorna:
+     *  - Posición del modelo elegido, su valor exacto y las evaluaciones ahorradas.
+     */
+    HalvingResult findBestModelHalving(const std::string& metric, const HalvingOptions& options = HalvingOptions(),
+                                       ThreadPool* pool = nullptr);
+
+    /*
+     * Método para ajustar directamente la recta óptima de una métrica.
+     * ------------------------------------------------------------
+     * Mínimos cuadrados para "MSE" y "RMSE", mínima desviación absoluta para
+     * "MAE" (ver RegressionFitter). El modelo no se añade al conjunto.
+     * Parámetros:
+     *  - string metric: "MAE", "MSE" o "RMSE".
+     *  - ThreadPool* pool: Grupo de hilos opcional para recorrer los puntos en paralelo.
+     * Retorna:
+     *  - Modelo ajustado con MAE, MSE y RMSE calculados.
+     */
+    LinearRegression<T> fitModel(const std::string& metric, ThreadPool* pool = nullptr);
+
+    /*
+     * Método para obtener los modelos como lista.
+     * ------------------------------------------------------------
+     * La lista se construye desde modelBank en cada llamada (O(P)) y es una
+     * copia: para editar un modelo se usa setModel.
+     * Retorna:
+     *  - Modelos con sus coeficientes, métricas y banderas, en orden de inserción.
+     */
+    std::list<LinearRegression<T>> models() const;
+
+    // Número de modelos del conjunto
+    std::size_t modelCount() const;
+
+    /*
+     * Método para reemplazar los coeficientes de un modelo.
+     * ------------------------------------------------------------
+     * Las métricas del modelo dejan de estar calculadas; en modo de flujo
+     * continuo se recalculan solo las de ese modelo.
+     * Parámetros:
+     *  - size_t i: Posición del modelo.
+     *  - double slope, double intercept: Coeficientes nuevos.
+     * Lanza std::out_of_range si no existe el modelo i.
+     */
+    void setModel(std::size_t i, double slope, double intercept);
+
+    /*
+     * Método para evaluar MSE y RMSE de todos los modelos en forma cerrada.
+     * ------------------------------------------------------------
+     * Usa el índice de momentos: O(N) para construirlo una vez y O(log N) por modelo.
+     * MAE no admite forma cerrada y se calcula con evaluateModels.
+     * Con datos enteros (predicción redondeada) recorre los puntos con el núcleo exacto.
+     */
+    void evaluateModelsClosedForm();
+
+    /*
+     * Método para encontrar el mejor modelo dentro de un rango de x.
+     * ------------------------------------------------------------
+     * Parámetros:
+     *  - string metric: "MSE" o "RMSE".
+     *  - T xLo, T xHi: Extremos (inclusivos) del rango de x.
+     * Retorna:
+     *  - Copia del mejor modelo con el MSE y RMSE del rango.
+     */
+    LinearRegression<T> findBestModelInRange(const std::string& metric, T xLo, T xHi);
+
+    /*
+     * Métodos de acceso a las columnas contiguas de puntos.
+     * ------------------------------------------------------------
+     * Retornan punteros al inicio de las columnas X e Y y el número de puntos.
+     */
+    const T* xData() const;
+    const T* yData() const;
+    std::size_t pointCount() const;
+
+    /*
+     * Método para usar columnas externas ya ordenadas sin copiarlas.
+     * ------------------------------------------------------------
+     * Reemplaza los puntos actuales por una vista de las columnas dadas.
+     * Parámetros:
+     *  - shared_ptr<const MappedFile> storage: Dueño de la memoria de las columnas.
+     *  - const T* xs, const T* ys: Columnas ordenadas por x.
+     *  - size_t count: Número de puntos.
+     */
+    void attachColumns(std::shared_ptr<const MappedFile> storage, const T* xs, const T* ys, std::size_t count);
+
+    // Indica si el conjunto trabaja sobre columnas proyectadas en memoria
+    bool isMapped() const;
+
+    /*
+     * Método para copiar las columnas proyectadas a la memoria propia del conjunto.
+     * ------------------------------------------------------------
+     * Se invoca automáticamente antes de modificar los puntos de un conjunto proyectado.
+     */
+    void materialize();
+
+    /*
+     * Método para activar el modo de flujo continuo.
+     * ------------------------------------------------------------
+     * A partir de aquí cada addDataPoint actualiza en O(P) el MAE, MSE y RMSE de
+     * todos los modelos, sin volver a evaluar. Con una ventana acotada se expulsan
+     * los puntos del frente (menor x; los más antiguos si x es el tiempo) y se
+     * resta su contribución.
+     * Parámetros:
+     *  - size_t maxPoints: Máximo de puntos en la ventana (0 = sin límite).
+     *  - double xHorizon: Se conservan los puntos con x >= x_max - xHorizon (0 = sin límite).
+     */
+    void enableStreaming(std::size_t maxPoints = 0, double xHorizon = 0.0);
+
+    // Método para desactivar el modo de flujo continuo
+    void disableStreaming();
+
+    /*
+     * Método para expulsar los puntos que quedan fuera de la ventana.
+     * ------------------------------------------------------------
+     * Parámetros:
+     *  - bool updateSums: Si se resta la contribución de cada punto expulsado.
+     */
+    void trimWindow(bool updateSums);
+
+    /*
+     * Método para sumar a las estadísticas las inserciones individuales acumuladas.
+     * ------------------------------------------------------------
+     * addDataPoint solo incrementa contadores propios; se reportan cada
+     * INSERT_REPORT_INTERVAL inserciones y al confirmar un lote o evaluar.
+     */
+    void reportInserts();
+
+    /*
+     * Método para obtener el MSE del modelo m sobre los puntos [first, last).
+     * ------------------------------------------------------------
+     * Con datos de punto flotante usa el índice de momentos, que debe estar
+     * construido. Con datos enteros la predicción se redondea, lo que no admite
+     * forma cerrada, y se evalúan los puntos con el núcleo exacto.
+     */
+    double rangeMeanSquaredError(std::size_t m, std::size_t first, std::size_t last) const;
 };
 
 #include "DataSet.hxx"
@@ -11,6 +11,13 @@
 
 #include "DataSet.h"
 #include "LinearRegression.h"
+#include "ParallelSort.h"
+#include "Stats.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 
 /*
  * Implementación del método addDataPoint
@@ -20,6 +27,13 @@
 template <typename T>
 void DataSet<T>::addDataPoint(T x, T y)
 {
+    if (batchOpen) {
+        pendingPoints.push_back(DataPoint<T>(x, y));
+        return;
+    }
+    if (isMapped())
+        materialize();
+
     // TODO #01: Implementar la inserción ordenada de puntos de datos en la estructura lineal.
     int inicio = 0;
     int fin = dataPoints.size(); // Usamos el tamaño total como límite superior
@@ -36,33 +50,177 @@ void DataSet<T>::addDataPoint(T x, T y)
     }
 
     // Al terminar el ciclo, 'inicio' es el índice exacto donde debe ir el nuevo elemento
+#ifdef CODE_STATS
+    ++unreportedInserts;
+    unreportedShifts += dataPoints.size() - inicio;
+    if (unreportedInserts == INSERT_REPORT_INTERVAL)
+        reportInserts();
+#endif
     dataPoints.insert(dataPoints.begin() + inicio, DataPoint<T>(x, y));
+    xColumn.insert(xColumn.begin() + columnHead + inicio, x);
+    yColumn.insert(yColumn.begin() + columnHead + inicio, y);
+    momentIndex.invalidate();
+
+    if (streaming) {
+        streamingMetrics.addPoint(*this, x, y);
+        trimWindow(true);
+        streamingMetrics.publish(*this);
+    }
+}
+
+/*
+ * Implementación del método addDataPoints
+ * ----------------------------------------
+ * Añade el rango al lote pendiente; si no había un lote abierto, lo abre y lo
+ * confirma al terminar.
+ */
+template <typename T>
+template <typename InputIt>
+void DataSet<T>::addDataPoints(InputIt first, InputIt last)
+{
+    bool ownBatch = !batchOpen;
+    if (ownBatch)
+        beginBatch();
+    pendingPoints.insert(pendingPoints.end(), first, last);
+    if (ownBatch)
+        commitBatch();
+}
+
+/*
+ * Implementación del método beginBatch
+ * -------------------------------------
+ * Abre una carga por lotes. Lanza una excepción si ya hay una abierta.
+ */
+template <typename T>
+void DataSet<T>::beginBatch(std::size_t expectedPoints)
+{
+    if (batchOpen)
+        throw std::logic_error("Ya hay una carga por lotes abierta");
+    batchOpen = true;
+    pendingPoints.reserve(pendingPoints.size() + expectedPoints);
+}
+
+/*
+ * Implementación del método commitBatch
+ * --------------------------------------
+ * Ordena de forma estable el lote pendiente, lo mezcla con los puntos ya
+ * ordenados y reconstruye las columnas contiguas.
+ */
+template <typename T>
+void DataSet<T>::commitBatch()
+{
+    if (!batchOpen)
+        throw std::logic_error("No hay una carga por lotes abierta");
+    batchOpen = false;
+    reportInserts();
+    if (pendingPoints.empty())
+        return;
+    STATS_TIMER(Insert);
+    STATS_COUNT(PointsInserted, pendingPoints.size());
+    if (isMapped())
+        materialize();
+
+    auto byX = [](const DataPoint<T>& a, const DataPoint<T>& b) { return a.x < b.x; };
+    parallelStableSort(pendingPoints, byX, sortThreads);
+
+    std::deque<DataPoint<T>> merged;
+    std::merge(dataPoints.begin(), dataPoints.end(), pendingPoints.begin(), pendingPoints.end(),
+               std::back_inserter(merged), byX);
+    dataPoints.swap(merged);
+    pendingPoints.clear();
+    pendingPoints.shrink_to_fit();
+
+    columnHead = 0;
+    xColumn.resize(dataPoints.size(), T());
+    yColumn.resize(dataPoints.size(), T());
+    for (std::size_t i = 0; i < dataPoints.size(); ++i) {
+        xColumn[i] = dataPoints[i].x;
+        yColumn[i] = dataPoints[i].y;
+    }
+    momentIndex.invalidate();
+
+    if (streaming) {
+        // Se recorta antes de recalcular para no evaluar puntos que se van a expulsar
+        trimWindow(false);
+        streamingMetrics.rebuild(*this);
+        streamingMetrics.publish(*this);
+    }
 }
 
 /*
  * Implementación del método addModel
  * -----------------------------------
  * Crea un nuevo modelo de regresión lineal con la pendiente y ordenada especificadas
- * y lo añade a la lista de modelos.
+ * y lo añade al banco de modelos.
  */
 template <typename T>
 void DataSet<T>::addModel(double slope, double intercept)
 {
     // TODO #02: Implementar la inserción de modelos de regresión en la lista.
-    models.push_back(LinearRegression<T>(slope, intercept));
+    modelBank.add(slope, intercept);
+
+    if (streaming) {
+        // Las sumas de los demás modelos siguen vigentes; solo se evalúa el nuevo
+        streamingMetrics.appendModel(*this, slope, intercept);
+        streamingMetrics.publish(*this);
+    }
+}
+
+/*
+ * Implementación del método addModel (modelo construido)
+ * -------------------------------------------------------
+ * Igual que addModel con coeficientes, pero copia al banco las métricas que
+ * el modelo ya trae calculadas.
+ */
+template <typename T>
+void DataSet<T>::addModel(const LinearRegression<T> &model)
+{
+    std::size_t i = modelBank.size();
+    modelBank.add(model.getSlope(), model.getIntercept());
+    if (model.isMAECalculated())
+        modelBank.template setMetric<Metric::MAE>(i, model.getMAE());
+    if (model.isMSECalculated())
+        modelBank.template setMetric<Metric::MSE>(i, model.getMSE());
+    if (model.isRMSECalculated())
+        modelBank.template setMetric<Metric::RMSE>(i, model.getRMSE());
+
+    if (streaming) {
+        streamingMetrics.appendModel(*this, model.getSlope(), model.getIntercept());
+        streamingMetrics.publish(*this);
+    }
+}
+
+/*
+ * Implementación del método setModel
+ * -----------------------------------
+ * Reemplaza los coeficientes en el banco y descarta sus métricas.
+ */
+template <typename T>
+void DataSet<T>::setModel(std::size_t i, double slope, double intercept)
+{
+    if (i >= modelBank.size())
+        throw std::out_of_range("No existe el modelo " + std::to_string(i));
+    modelBank.replace(i, slope, intercept);
+
+    if (streaming) {
+        streamingMetrics.replaceModel(*this, i);
+        streamingMetrics.publish(*this);
+    }
 }
 
 /*
  * Implementación del método evaluateModels
  * -----------------------------------------
  * Evalúa todos los modelos de regresión almacenados utilizando los datos actuales.
+ * calculateMetrics recorre todos los modelos del banco, no solo el que la invoca.
  */
 template <typename T>
 void DataSet<T>::evaluateModels()
 {
     // TODO #7: Implementar la función evaluateModels.
-    if (!models.empty()) {
-        models.begin()->calculateMetrics(*this);
+    reportInserts();
+    if (modelBank.size() > 0) {
+        modelBank.toModel(0).calculateMetrics(*this);
     }
 }
 
@@ -70,48 +228,313 @@ void DataSet<T>::evaluateModels()
  * Implementación del método findBestModel
  * ----------------------------------------
  * Encuentra el modelo de regresión con el mejor ajuste basado en la métrica dada como parámetro.
+ * Traduce el nombre a Metric y recorre los valores contiguos del banco de modelos.
  */
 template <typename T>
 LinearRegression<T> DataSet<T>::findBestModel(const std::string &metric)
 {
-    if (models.empty())
+    if (modelBank.size() == 0)
         throw std::runtime_error("No hay modelos disponibles para evaluar.");
     // TODO #8: Implementar la función findBestModel.
-    LinearRegression<T> bestModel;
-    typename std::list <LinearRegression<T>>::iterator iter = models.begin();
-    double bestValue;
-    if (metric == "MAE") {
-        bestValue = iter->getMAE();
-        for(; iter != models.end(); ++iter) {
-            if (iter->getMAE() < bestValue) {
-                bestValue = iter->getMAE();
-                bestModel = *iter;
-            }
-        }
+    std::vector<std::size_t> best;
+    switch (metricFromName(metric)) {
+    case Metric::MAE:
+        best = findTopK<Metric::MAE>(1);
+        break;
+    case Metric::MSE:
+        best = findTopK<Metric::MSE>(1);
+        break;
+    default:
+        best = findTopK<Metric::RMSE>(1);
+        break;
+    }
+    return modelBank.toModel(best.front());
+}
 
-    }else if (metric == "MSE") {
-        bestValue = iter->getMSE();
-        for(; iter != models.end(); ++iter) {
-            if (iter->getMSE() < bestValue) {
-                bestValue = iter->getMSE();
-                bestModel = *iter;
-            }
-        }
+/*
+ * Implementación del método findTopK
+ * -----------------------------------
+ * Selección parcial de los k mejores sobre el banco de modelos.
+ */
+template <typename T>
+template <Metric M>
+std::vector<std::size_t> DataSet<T>::findTopK(std::size_t k)
+{
+    STATS_TIMER(Select);
+    return modelBank.template findTopK<M>(k);
+}
 
-    }else if (metric == "RMSE") {
-        bestValue = iter->getRMSE();
-        for(; iter != models.end(); ++iter) {
-            if (iter->getRMSE() < bestValue) {
-                bestValue = iter->getRMSE();
-                bestModel = *iter;
-            }
-        }
+/*
+ * Implementación del método findBestModels
+ * -----------------------------------------
+ * Una sola pasada por el banco para las tres métricas.
+ */
+template <typename T>
+BestModelIndices DataSet<T>::findBestModels()
+{
+    STATS_TIMER(Select);
+    return modelBank.findBest();
+}
+
+template <typename T>
+HalvingResult DataSet<T>::findBestModelHalving(const std::string &metric, const HalvingOptions &options, ThreadPool *pool)
+{
+    return SuccessiveHalving<T>(options, pool).select(*this, metricFromName(metric));
+}
+
+template <typename T>
+LinearRegression<T> DataSet<T>::fitModel(const std::string &metric, ThreadPool *pool)
+{
+    return RegressionFitter<T>(pool).fit(*this, metricFromName(metric));
+}
+
+/*
+ * Implementación del método models
+ * ---------------------------------
+ * Copia cada posición del banco a un LinearRegression, con sus métricas.
+ */
+template <typename T>
+std::list<LinearRegression<T>> DataSet<T>::models() const
+{
+    std::list<LinearRegression<T>> list;
+    for (std::size_t i = 0; i < modelBank.size(); ++i)
+        list.push_back(modelBank.toModel(i));
+    return list;
+}
+
+template <typename T>
+std::size_t DataSet<T>::modelCount() const
+{
+    return modelBank.size();
+}
+
+/*
+ * Implementación del método evaluateModelsClosedForm
+ * ---------------------------------------------------
+ * Construye el índice de momentos si está desactualizado y asigna a cada modelo
+ * su MSE y RMSE sin recorrer los puntos.
+ */
+template <typename T>
+void DataSet<T>::evaluateModelsClosedForm()
+{
+    STATS_TIMER(Evaluate);
+    if (pointCount() == 0)
+        throw std::runtime_error("El conjunto de datos está vacío");
+    if (!EvaluationTraits<T>::exactInteger && !momentIndex.isBuilt())
+        momentIndex.build(*this);
+
+    for (std::size_t m = 0; m < modelBank.size(); ++m) {
+        double mse = rangeMeanSquaredError(m, 0, pointCount());
+        modelBank.template setMetric<Metric::MSE>(m, mse);
+        modelBank.template setMetric<Metric::RMSE>(m, std::sqrt(mse));
+    }
+}
+
+template <typename T>
+double DataSet<T>::rangeMeanSquaredError(std::size_t m, std::size_t first, std::size_t last) const
+{
+    if (first >= last)
+        throw std::runtime_error("No hay puntos en el rango solicitado");
+    if constexpr (EvaluationTraits<T>::exactInteger) {
+        ResidualSums sums = chunkedResidualSums(xData() + first, yData() + first, last - first,
+                                                modelBank.slopes[m], modelBank.intercepts[m]);
+        return sums.sumSquaredError / static_cast<double>(last - first);
+    } else {
+        return momentIndex.meanSquaredError(*this, modelBank.slopes[m], modelBank.intercepts[m], first, last);
+    }
+}
 
-    }else {
+/*
+ * Implementación del método findBestModelInRange
+ * -----------------------------------------------
+ * Localiza el rango con búsqueda binaria y compara los modelos por su MSE en
+ * forma cerrada. Como RMSE es monótono en MSE, ambas métricas eligen el mismo modelo.
+ */
+template <typename T>
+LinearRegression<T> DataSet<T>::findBestModelInRange(const std::string &metric, T xLo, T xHi)
+{
+    if (modelBank.size() == 0)
+        throw std::runtime_error("No hay modelos disponibles para evaluar.");
+    if (metric == "MAE")
+        throw std::invalid_argument("MAE no admite evaluación en forma cerrada por rango");
+    if (metric != "MSE" && metric != "RMSE")
         throw std::invalid_argument("Métrica no reconocida: " + metric);
+    STATS_TIMER(Select);
+    if (!EvaluationTraits<T>::exactInteger && !momentIndex.isBuilt())
+        momentIndex.build(*this);
+
+    std::pair<std::size_t, std::size_t> range = momentIndex.rangeOf(*this, xLo, xHi);
+    std::size_t best = 0;
+    double bestValue = 0.0;
+    for (std::size_t m = 0; m < modelBank.size(); ++m) {
+        double value = rangeMeanSquaredError(m, range.first, range.second);
+        if (m == 0 || value < bestValue) {
+            best = m;
+            bestValue = value;
+        }
     }
 
+    LinearRegression<T> bestModel(modelBank.slopes[best], modelBank.intercepts[best]);
+    bestModel.setMSE(bestValue);
+    bestModel.setRMSE(std::sqrt(bestValue));
+    bestModel.setMSECalculated(true);
+    bestModel.setRMSECalculated(true);
     return bestModel;
 }
 
+/*
+ * Implementación de los métodos de acceso a las columnas
+ * -------------------------------------------------------
+ * Exponen las columnas contiguas de X e Y para el núcleo de evaluación.
+ */
+template <typename T>
+const T* DataSet<T>::xData() const
+{
+    return isMapped() ? mappedX : xColumn.data() + columnHead;
+}
+
+template <typename T>
+const T* DataSet<T>::yData() const
+{
+    return isMapped() ? mappedY : yColumn.data() + columnHead;
+}
+
+template <typename T>
+std::size_t DataSet<T>::pointCount() const
+{
+    return isMapped() ? mappedCount : xColumn.size() - columnHead;
+}
+
+/*
+ * Implementación del método attachColumns
+ * ----------------------------------------
+ * Descarta los puntos propios y pasa a evaluar directamente sobre las columnas
+ * externas, que deben estar ordenadas por x.
+ */
+template <typename T>
+void DataSet<T>::attachColumns(std::shared_ptr<const MappedFile> storage, const T* xs, const T* ys, std::size_t count)
+{
+    if (batchOpen)
+        throw std::logic_error("No se pueden asociar columnas con una carga por lotes abierta");
+    dataPoints.clear();
+    xColumn.clear();
+    yColumn.clear();
+    columnHead = 0;
+    mappedStorage = storage;
+    mappedX = xs;
+    mappedY = ys;
+    mappedCount = count;
+    momentIndex.invalidate();
+    STATS_COUNT(PointsInserted, count);
+}
+
+/*
+ * Implementación del método reportInserts
+ * ----------------------------------------
+ * Suma los contadores propios a las estadísticas globales y los reinicia, de
+ * modo que cada inserción individual no paga un incremento atómico.
+ */
+template <typename T>
+void DataSet<T>::reportInserts()
+{
+    STATS_COUNT(PointsInserted, unreportedInserts);
+    STATS_COUNT(InsertShifts, unreportedShifts);
+    unreportedInserts = 0;
+    unreportedShifts = 0;
+}
+
+template <typename T>
+bool DataSet<T>::isMapped() const
+{
+    return mappedStorage != nullptr;
+}
+
+/*
+ * Implementación del método materialize
+ * --------------------------------------
+ * Copia las columnas proyectadas a dataPoints, xColumn e yColumn y libera la proyección.
+ */
+template <typename T>
+void DataSet<T>::materialize()
+{
+    if (!isMapped())
+        return;
+    xColumn.assign(mappedX, mappedX + mappedCount);
+    yColumn.assign(mappedY, mappedY + mappedCount);
+    columnHead = 0;
+    dataPoints.clear();
+    for (std::size_t i = 0; i < mappedCount; ++i)
+        dataPoints.push_back(DataPoint<T>(mappedX[i], mappedY[i]));
+    mappedStorage.reset();
+    mappedX = nullptr;
+    mappedY = nullptr;
+    mappedCount = 0;
+}
+
+/*
+ * Implementación del método enableStreaming
+ * ------------------------------------------
+ * Calcula una vez las sumas de todos los modelos sobre los puntos actuales,
+ * aplica la ventana y publica las métricas.
+ */
+template <typename T>
+void DataSet<T>::enableStreaming(std::size_t maxPoints, double xHorizon)
+{
+    if (batchOpen)
+        throw std::logic_error("No se puede activar el modo de flujo con una carga por lotes abierta");
+    if (xHorizon < 0.0)
+        throw std::invalid_argument("El horizonte de la ventana no puede ser negativo");
+    materialize();
+    streaming = true;
+    windowMaxPoints = maxPoints;
+    windowHorizon = xHorizon;
+    trimWindow(false);
+    streamingMetrics.rebuild(*this);
+    streamingMetrics.publish(*this);
+}
+
+template <typename T>
+void DataSet<T>::disableStreaming()
+{
+    streaming = false;
+}
+
+/*
+ * Implementación del método trimWindow
+ * -------------------------------------
+ * Expulsa del frente los puntos que exceden el máximo de la ventana o que
+ * quedan fuera del horizonte respecto al mayor x. Las columnas solo avanzan
+ * columnHead y se compactan cuando la parte descartada supera a la vigente,
+ * por lo que cada expulsión cuesta O(1) amortizado más O(P) de las sumas.
+ */
+template <typename T>
+void DataSet<T>::trimWindow(bool updateSums)
+{
+    bool evicted = false;
+    while (!dataPoints.empty()) {
+        const DataPoint<T>& front = dataPoints.front();
+        bool overCount = windowMaxPoints > 0 && dataPoints.size() > windowMaxPoints;
+        bool overHorizon = windowHorizon > 0.0 &&
+                           static_cast<double>(front.x) < static_cast<double>(dataPoints.back().x) - windowHorizon;
+        if (!overCount && !overHorizon)
+            break;
+        if (updateSums)
+            streamingMetrics.removePoint(*this, front.x, front.y);
+        dataPoints.pop_front();
+        ++columnHead;
+        evicted = true;
+    }
+    if (!evicted)
+        return;
+
+    if (columnHead >= xColumn.size() - columnHead) {
+        xColumn.erase(xColumn.begin(), xColumn.begin() + columnHead);
+        yColumn.erase(yColumn.begin(), yColumn.begin() + columnHead);
+        columnHead = 0;
+    }
+    momentIndex.invalidate();
+    if (updateSums && streamingMetrics.needsRefresh(pointCount()))
+        streamingMetrics.rebuild(*this);
+}
+
 #endif // DATASET_HXX
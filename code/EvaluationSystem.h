@@ -10,6 +10,12 @@
 #define EVALUATIONSYSTEM_H
 
 #include "DataSet.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
 #include <vector>
 
 /*
@@ -27,6 +33,18 @@ template <typename T>
 class EvaluationSystem {
 public:
     DataSet<T> dataSet;  // Conjunto de datos gestionado por el sistema
+    std::size_t threadCount = 1;        // Hilos usados por runEvaluation (1 = secuencial)
+    std::shared_ptr<ThreadPool> pool;   // Grupo de hilos, creado al evaluar en paralelo
+
+    /*
+     * Método para configurar el número de hilos de la evaluación.
+     * ----------------------------------------------
+     * También limita los hilos del ordenamiento de las cargas por lotes.
+     * Parámetros:
+     *  - size_t threads: Hilos a usar; 0 usa todos los núcleos disponibles.
+     */
+    void setThreadCount(std::size_t threads);
+    std::size_t getThreadCount() const;
 
     /*
      * Método para añadir un punto de datos al conjunto.
@@ -37,6 +55,16 @@ public:
      */
     void addDataPoint(T x, T y);
 
+    /*
+     * Métodos para la carga masiva de puntos de datos.
+     * ----------------------------------------------
+     * Delegan en DataSet::addDataPoints, beginBatch y commitBatch.
+     */
+    template <typename InputIt>
+    void addDataPoints(InputIt first, InputIt last);
+    void beginBatch(std::size_t expectedPoints = 0);
+    void commitBatch();
+
     /*
      * Método para añadir un modelo de regresión lineal al conjunto.
      * ------------------------------------------------------------
@@ -46,10 +74,21 @@ public:
      */
     void addModel(double slope, double intercept);
 
+    /*
+     * Métodos para el modo de flujo continuo con ventana deslizante.
+     * ------------------------------------------------------------
+     * Delegan en DataSet::enableStreaming y DataSet::disableStreaming. Mientras
+     * está activo, las métricas de cada modelo se mantienen al día en cada
+     * addDataPoint sin necesidad de llamar a runEvaluation.
+     */
+    void enableStreaming(std::size_t maxPoints = 0, double xHorizon = 0.0);
+    void disableStreaming();
+
     /*
      * Método para ejecutar la evaluación de los modelos de regresión.
      * ------------------------------------------------------------
      * Calcula las métricas de error para cada modelo almacenado en el conjunto de datos.
+     * Con más de un hilo usa ParallelEvaluator; los resultados no dependen del número de hilos.
      */
     void runEvaluation();
 
@@ -57,15 +96,52 @@ public:
      * Método para imprimir los resultados de la evaluación.
      * -----------------------------------------------------
      * Muestra las métricas de error calculadas para cada modelo en el conjunto.
+     * Escribe en out (por omisión la salida estándar).
      */
-    void printResults();
+    void printResults(std::ostream& out = std::cout);
 
     /*
      * Método para imprimir los mejores modelos basados en las métricas de error.
      * --------------------------------------------------------------------
      * Identifica y muestra los modelos con el mejor desempeño según las métricas evaluadas.
+     * Escribe en out (por omisión la salida estándar).
+     */
+    void printBestModels(std::ostream& out = std::cout);
+
+    /*
+     * Método para encontrar el mejor modelo por eliminación sucesiva.
+     * --------------------------------------------------------------------
+     * No requiere runEvaluation; usa el grupo de hilos si threadCount > 1.
+     */
+    HalvingResult findBestModelHalving(const std::string& metric, const HalvingOptions& options);
+
+    /*
+     * Método para imprimir los mejores modelos obtenidos por eliminación sucesiva.
+     * --------------------------------------------------------------------
+     * Para cada métrica muestra el modelo elegido, su valor exacto y las
+     * evaluaciones modelo·punto realizadas frente a la evaluación completa.
      */
-    void printBestModels();
+    void printBestModelsHalving(const HalvingOptions& options, std::ostream& out = std::cout);
+
+    /*
+     * Método para ajustar directamente la recta óptima de una métrica.
+     * --------------------------------------------------------------------
+     * Delega en DataSet::fitModel; usa el grupo de hilos si threadCount > 1.
+     */
+    LinearRegression<T> fitModel(const std::string& metric);
+
+    /*
+     * Método para ajustar e imprimir las rectas óptimas.
+     * --------------------------------------------------------------------
+     * Ajusta la recta de mínima desviación absoluta (óptimo de MAE) y la de
+     * mínimos cuadrados (óptimo de MSE y RMSE), las añade al conjunto como
+     * modelos evaluados y muestra su ecuación y sus métricas.
+     */
+    void printFittedModels(std::ostream& out = std::cout);
+
+private:
+    // Grupo de hilos de la evaluación; nullptr si threadCount <= 1
+    ThreadPool* evaluationPool();
 };
 
 #include "EvaluationSystem.hxx"
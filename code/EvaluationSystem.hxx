@@ -10,7 +10,10 @@
 #define EVALUATIONSYSTEM_HXX
 
 #include "EvaluationSystem.h"
+#include "ParallelEvaluator.h"
+#include "Stats.h"
 #include <iostream>
+#include <thread>
 
 // Método para añadir un punto de datos al conjunto
 template <typename T>
@@ -18,75 +21,183 @@ void EvaluationSystem<T>::addDataPoint(T x, T y) {
     this->dataSet.addDataPoint(x, y);
 }
 
+// Métodos para la carga masiva de puntos de datos
+template <typename T>
+template <typename InputIt>
+void EvaluationSystem<T>::addDataPoints(InputIt first, InputIt last) {
+    this->dataSet.addDataPoints(first, last);
+}
+
+template <typename T>
+void EvaluationSystem<T>::beginBatch(std::size_t expectedPoints) {
+    this->dataSet.beginBatch(expectedPoints);
+}
+
+template <typename T>
+void EvaluationSystem<T>::commitBatch() {
+    this->dataSet.commitBatch();
+}
+
 // Método para añadir un modelo de regresión lineal al conjunto
 template <typename T>
 void EvaluationSystem<T>::addModel(double slope, double intercept) {
     this->dataSet.addModel(slope, intercept);
 }
 
+// Método para configurar el número de hilos de la evaluación
+template <typename T>
+void EvaluationSystem<T>::setThreadCount(std::size_t threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads != threadCount)
+        pool.reset();
+    threadCount = threads;
+    this->dataSet.sortThreads = threads;
+}
+
+template <typename T>
+std::size_t EvaluationSystem<T>::getThreadCount() const {
+    return threadCount;
+}
+
+// Métodos para el modo de flujo continuo
+template <typename T>
+void EvaluationSystem<T>::enableStreaming(std::size_t maxPoints, double xHorizon) {
+    this->dataSet.enableStreaming(maxPoints, xHorizon);
+}
+
+template <typename T>
+void EvaluationSystem<T>::disableStreaming() {
+    this->dataSet.disableStreaming();
+}
+
 // Método para ejecutar la evaluación de los modelos de regresión
 template <typename T>
 void EvaluationSystem<T>::runEvaluation() {
-    this->dataSet.evaluateModels();
+    if (threadCount <= 1) {
+        this->dataSet.evaluateModels();
+        return;
+    }
+    ParallelEvaluator<T>(*evaluationPool()).evaluate(this->dataSet);
+}
+
+template <typename T>
+ThreadPool* EvaluationSystem<T>::evaluationPool() {
+    if (threadCount <= 1)
+        return nullptr;
+    // El hilo llamador también trabaja, por eso el grupo tiene threadCount - 1 hilos
+    if (!pool)
+        pool = std::make_shared<ThreadPool>(threadCount - 1);
+    return pool.get();
+}
+
+template <typename T>
+HalvingResult EvaluationSystem<T>::findBestModelHalving(const std::string& metric, const HalvingOptions& options) {
+    return this->dataSet.findBestModelHalving(metric, options, evaluationPool());
+}
+
+template <typename T>
+LinearRegression<T> EvaluationSystem<T>::fitModel(const std::string& metric) {
+    return this->dataSet.fitModel(metric, evaluationPool());
+}
+
+// Método para ajustar, añadir e imprimir las rectas óptimas de MAE y de MSE/RMSE
+template <typename T>
+void EvaluationSystem<T>::printFittedModels(std::ostream& out) {
+    // Métrica que se optimiza, nombre del ajuste y métricas de las que es óptimo
+    const char* fits[][3] = {{"MAE", "minima desviacion absoluta", "MAE"}, {"MSE", "minimos cuadrados", "MSE y RMSE"}};
+    for (const auto& fit : fits) {
+        try {
+            LinearRegression<T> model = fitModel(fit[0]);
+            this->dataSet.addModel(model);
+            STATS_TIMER(Output);
+            out << "Recta ajustada por " << fit[1] << " (optimo de " << fit[2] << "):\n";
+            out << "  Ecuacion del modelo: y = " << model.getSlope() << " x + " << model.getIntercept() << "\n";
+            out << "  MAE: " << model.getMAE() << "\n";
+            out << "  MSE: " << model.getMSE() << "\n";
+            out << "  RMSE: " << model.getRMSE() << "\n";
+        } catch (const std::exception& e) {
+            out << "Error al ajustar la recta por " << fit[1] << ": " << e.what() << '\n';
+        }
+    }
 }
 
 // Método para imprimir los resultados de la evaluación
 template <typename T>
-void EvaluationSystem<T>::printResults() {
-    const std::list<LinearRegression<T>>& models = dataSet.models;
+void EvaluationSystem<T>::printResults(std::ostream& out) {
+    const std::list<LinearRegression<T>> models = dataSet.models();
     if (models.empty()) {
-        std::cout << "No hay modelos para evaluar." << std::endl;
+        out << "No hay modelos para evaluar." << '\n';
         return;
     }
 
     int index = 1;
-    for (typename std::list<LinearRegression<T>>::const_iterator it = dataSet.models.begin(); it != dataSet.models.end(); ++it) {
-        std::cout << "Modelo " << index++ << ":\n";
-        std::cout << "  Ecuacion del modelo: y = " << it->getSlope() << " x + " << it->getIntercept() << "\n";
+    for (typename std::list<LinearRegression<T>>::const_iterator it = models.begin(); it != models.end(); ++it) {
+        out << "Modelo " << index++ << ":\n";
+        out << "  Ecuacion del modelo: y = " << it->getSlope() << " x + " << it->getIntercept() << "\n";
         
         if (it->isMAECalculated()) {
-            std::cout << " -> MAE: " << it->getMAE() << "\n";
+            out << " -> MAE: " << it->getMAE() << "\n";
         }
         if (it->isMSECalculated()) {
-            std::cout << " -> MSE: " << it->getMSE() << "\n";
+            out << " -> MSE: " << it->getMSE() << "\n";
         }
         if (it->isRMSECalculated()) {
-            std::cout << " -> RMSE: " << it->getRMSE() << "\n";
+            out << " -> RMSE: " << it->getRMSE() << "\n";
         }
     }
 }
 
 // Método para imprimir el mejor modelo basado en las métricas de error
+// Los tres mejores modelos se obtienen con una sola pasada por el banco de modelos
 template <typename T>
-void EvaluationSystem<T>::printBestModels() {
-    try {
-        LinearRegression<T> bestModelMAE = this->dataSet.findBestModel("MAE");
-        std::cout << "Mejor modelo basado en MAE:\n";
-        std::cout << "  Ecuacion del modelo: y = " << bestModelMAE.getSlope() << " x + " << bestModelMAE.getIntercept() << "\n";
-        std::cout << "  MAE: " << bestModelMAE.getMAE() << "\n";
-    } catch (const std::exception& e) {
-        std::cout << "Error al buscar el mejor modelo basado en MAE: " << e.what() << std::endl;
+void EvaluationSystem<T>::printBestModels(std::ostream& out) {
+    if (this->dataSet.modelCount() == 0) {
+        const char* metrics[] = {"MAE", "MSE", "RMSE"};
+        for (const char* metric : metrics)
+            out << "Error al buscar el mejor modelo basado en " << metric << ": No hay modelos disponibles para evaluar." << '\n';
+        return;
     }
 
-    try {
-        LinearRegression<T> bestModelMSE = this->dataSet.findBestModel("MSE");
-        std::cout << "Mejor modelo basado en MSE:\n";
-        std::cout << "  Ecuacion del modelo: y = " << bestModelMSE.getSlope() << " x + " << bestModelMSE.getIntercept() << "\n";
-        std::cout << "  MSE: " << bestModelMSE.getMSE() << "\n";
-    } catch (const std::exception& e) {
-        std::cout << "Error al buscar el mejor modelo basado en MSE: " << e.what() << std::endl;
-    }
+    BestModelIndices best = this->dataSet.findBestModels();
+    const ModelBank<T>& bank = this->dataSet.modelBank;
+    const Metric metrics[] = {Metric::MAE, Metric::MSE, Metric::RMSE};
+    const std::size_t indices[] = {best.mae, best.mse, best.rmse};
+    const std::vector<double>* values[] = {&bank.maeValues, &bank.mseValues, &bank.rmseValues};
 
-    try {
-        LinearRegression<T> bestModelRMSE = this->dataSet.findBestModel("RMSE");
-        std::cout << "Mejor modelo basado en RMSE:\n";
-        std::cout << "  Ecuacion del modelo: y = " << bestModelRMSE.getSlope() << " x + " << bestModelRMSE.getIntercept() << "\n";
-        std::cout << "  RMSE: " << bestModelRMSE.getRMSE() << "\n";
-    } catch (const std::exception& e) {
-        std::cout << "Error al buscar el mejor modelo basado en RMSE: " << e.what() << std::endl;
+    for (int k = 0; k < 3; ++k) {
+        if (indices[k] == NO_MODEL) {
+            out << "Error al buscar el mejor modelo basado en " << metricName(metrics[k]) << ": "
+                      << metricName(metrics[k]) << " no ha sido calculado" << '\n';
+            continue;
+        }
+        out << "Mejor modelo basado en " << metricName(metrics[k]) << ":\n";
+        out << "  Ecuacion del modelo: y = " << bank.slopes[indices[k]] << " x + " << bank.intercepts[indices[k]] << "\n";
+        out << "  " << metricName(metrics[k]) << ": " << (*values[k])[indices[k]] << "\n";
     }
 }
 
 
 
+// Método para imprimir los mejores modelos obtenidos por eliminación sucesiva
+template <typename T>
+void EvaluationSystem<T>::printBestModelsHalving(const HalvingOptions& options, std::ostream& out) {
+    const char* metrics[] = {"MAE", "MSE", "RMSE"};
+    for (const char* metric : metrics) {
+        try {
+            HalvingResult result = findBestModelHalving(metric, options);
+            STATS_TIMER(Output);
+            const ModelBank<T>& bank = this->dataSet.modelBank;
+            out << "Mejor modelo basado en " << metric << " (eliminacion sucesiva, tolerancia " << options.tolerance << "):\n";
+            out << "  Ecuacion del modelo: y = " << bank.slopes[result.best] << " x + " << bank.intercepts[result.best] << "\n";
+            out << "  " << metric << ": " << result.value << "\n";
+            out << "  Evaluaciones modelo-punto: " << result.evaluations << " de " << result.exhaustiveEvaluations
+                << " (ahorradas " << result.savedEvaluations << ", " << result.rounds << " rondas, "
+                << result.finalists << " finalistas)\n";
+        } catch (const std::exception& e) {
+            out << "Error al buscar el mejor modelo basado en " << metric << ": " << e.what() << '\n';
+        }
+    }
+}
+
 #endif // EVALUATIONSYSTEM_HXX
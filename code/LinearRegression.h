@@ -14,6 +14,8 @@ class DataSet;
 
 #include "DataSet.h"
 #include "DataPoint.h"
+#include "MetricsKernel.h"
+#include <cstddef>
 
 /*
  * Plantilla de clase LinearRegression
@@ -56,6 +58,9 @@ public:
     // Método para calcular la métrica RMSE basada en un conjunto de datos
     void calculateRMSE( DataSet<T> &dataSet);
 
+    // Método para asignar MAE, MSE y RMSE a partir de las sumas de residuos de n puntos
+    void storeMetrics(const ResidualSums &sums, std::size_t pointCount);
+
     // Método para predecir un valor basado en un DataPoint
     DataPoint<T> predict(const DataPoint<T> &inputPoint) const;
 
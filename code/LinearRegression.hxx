@@ -10,6 +10,8 @@
 
 #include "LinearRegression.h"
 #include "DataSet.h"
+#include "ModelBank.h"
+#include "Stats.h"
 #include <cmath>
 #include <stdexcept>
 #include <deque>
@@ -39,18 +41,27 @@ LinearRegression<T>::LinearRegression(double slope, double intercept) : slope(sl
  * Implementación del método calculateMetrics
  * ------------------------------------------
  * Calcula todas las métricas (MAE, MSE, RMSE) para el conjunto de datos proporcionado.
+ * Cada modelo se evalúa con una sola pasada del núcleo fusionado sobre las columnas
+ * contiguas del conjunto, en lugar de una pasada por métrica, usando la misma
+ * reducción por bloques que la evaluación en paralelo. Los coeficientes se leen
+ * del banco de modelos y los resultados se guardan en él.
  * Lanza una excepción si el conjunto de datos está vacío.
  */
 template <typename T>
 void LinearRegression<T>::calculateMetrics(DataSet<T> &dataSet)
 {
-    if (dataSet.dataPoints.empty())
+    STATS_TIMER(Evaluate);
+    if (dataSet.pointCount() == 0)
     {
         throw std::runtime_error("El conjunto de datos está vacío");
     }
-    calculateMAE(dataSet);
-    calculateMSE(dataSet);
-    calculateRMSE(dataSet);
+    ModelBank<T> &bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * dataSet.pointCount());
+    for (std::size_t m = 0; m < bank.size(); m++) {
+        ResidualSums sums = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                                bank.slopes[m], bank.intercepts[m]);
+        bank.store(m, sums, dataSet.pointCount());
+    }
 }
 
 /*
@@ -62,21 +73,19 @@ void LinearRegression<T>::calculateMetrics(DataSet<T> &dataSet)
 template <typename T>
 void LinearRegression<T>::calculateMAE(DataSet<T> &dataSet)
 {
-    if (dataSet.dataPoints.empty())
+    STATS_TIMER(Evaluate);
+    if (dataSet.pointCount() == 0)
     {
         throw std::runtime_error("El conjunto de datos está vacío");
     }
     // TODO #04: Implementar el cálculo de MAE.
-    typename std::list<LinearRegression<T>>::iterator it_models = dataSet.models.begin();
-    typename std::deque<DataPoint<T>>::iterator it_dataPoints;
-    for (;it_models != dataSet.models.end();it_models++) {
-        double sumAbsoluteError = 0.0;
-        for (it_dataPoints = dataSet.dataPoints.begin();it_dataPoints != dataSet.dataPoints.end();it_dataPoints++) {
-             sumAbsoluteError += std::abs(it_dataPoints->y - it_models -> predict(*it_dataPoints).y);
-        }
-        double finalMAE = sumAbsoluteError /dataSet.dataPoints.size();
-        it_models->setMAE(finalMAE);
-        it_models->setMAECalculated(true);
+    ModelBank<T> &bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * dataSet.pointCount());
+    for (std::size_t m = 0; m < bank.size(); m++) {
+        ResidualSums sums = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                                bank.slopes[m], bank.intercepts[m]);
+        double finalMAE = sums.sumAbsoluteError / dataSet.pointCount();
+        bank.template setMetric<Metric::MAE>(m, finalMAE);
     }
 }
 
@@ -89,21 +98,19 @@ void LinearRegression<T>::calculateMAE(DataSet<T> &dataSet)
 template <typename T>
 void LinearRegression<T>::calculateMSE(DataSet<T> &dataSet)
 {
-    if (dataSet.dataPoints.empty())
+    STATS_TIMER(Evaluate);
+    if (dataSet.pointCount() == 0)
     {
         throw std::runtime_error("El conjunto de datos está vacío");
     }
     // TODO #05: Implementar el cálculo de MSE.
-    typename std::list<LinearRegression<T>>::iterator it_models = dataSet.models.begin();
-    typename std::deque<DataPoint<T>>::iterator it_dataPoints;
-    for (;it_models != dataSet.models.end();it_models++) {
-        double sumSquaredError = 0.0;
-        for (it_dataPoints= dataSet.dataPoints.begin();it_dataPoints != dataSet.dataPoints.end();it_dataPoints++) {
-            sumSquaredError += std::pow(it_dataPoints->y - it_models -> predict(*it_dataPoints).y,2);
-        }
-        double finalMSE = sumSquaredError / dataSet.dataPoints.size();
-        it_models->setMSE(finalMSE);
-        it_models->setMSECalculated(true);
+    ModelBank<T> &bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * dataSet.pointCount());
+    for (std::size_t m = 0; m < bank.size(); m++) {
+        ResidualSums sums = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                                bank.slopes[m], bank.intercepts[m]);
+        double finalMSE = sums.sumSquaredError / dataSet.pointCount();
+        bank.template setMetric<Metric::MSE>(m, finalMSE);
     }
 }
 
@@ -116,25 +123,41 @@ void LinearRegression<T>::calculateMSE(DataSet<T> &dataSet)
 template <typename T>
 void LinearRegression<T>::calculateRMSE(DataSet<T> &dataSet)
 {
-    if (dataSet.dataPoints.empty())
+    STATS_TIMER(Evaluate);
+    if (dataSet.pointCount() == 0)
     {
         throw std::runtime_error("El conjunto de datos está vacío");
     }
     // TODO #06: Implementar el cálculo de RMSE.
-    typename std::list<LinearRegression<T>>::iterator it_models = dataSet.models.begin();
-    typename std::deque<DataPoint<T>>::iterator it_dataPoints;
-    for (;it_models != dataSet.models.end();it_models++) {
-        double sumAbsoluteError = 0.0;
-        for (it_dataPoints= dataSet.dataPoints.begin();it_dataPoints != dataSet.dataPoints.end();it_dataPoints++) {
-            sumAbsoluteError += std::pow(it_dataPoints->y - it_models -> predict(*it_dataPoints).y,2);
-        }
-        double finalRMSE = sumAbsoluteError /dataSet.dataPoints.size();
+    ModelBank<T> &bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * dataSet.pointCount());
+    for (std::size_t m = 0; m < bank.size(); m++) {
+        ResidualSums sums = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                                bank.slopes[m], bank.intercepts[m]);
+        double finalRMSE = sums.sumSquaredError / dataSet.pointCount();
         finalRMSE = sqrt(finalRMSE);
-        it_models->setRMSE(finalRMSE);
-        it_models->setRMSECalculated(true);
+        bank.template setMetric<Metric::RMSE>(m, finalRMSE);
     }
 }
 
+/*
+ * Implementación del método storeMetrics
+ * ---------------------------------------
+ * Convierte las sumas de residuos en MAE, MSE y RMSE y las marca como calculadas.
+ */
+template <typename T>
+void LinearRegression<T>::storeMetrics(const ResidualSums &sums, std::size_t pointCount)
+{
+    const double n = static_cast<double>(pointCount);
+    const double finalMSE = sums.sumSquaredError / n;
+    setMAE(sums.sumAbsoluteError / n);
+    setMSE(finalMSE);
+    setRMSE(std::sqrt(finalMSE));
+    setMAECalculated(true);
+    setMSECalculated(true);
+    setRMSECalculated(true);
+}
+
 /*
  * Implementación del método predict
  * ----------------------------------
@@ -144,7 +167,7 @@ template <typename T>
 DataPoint<T> LinearRegression<T>::predict(const DataPoint<T> &inputPoint) const
 {
     // TODO #03: Implementar la función predict.
-    return DataPoint<T>(inputPoint.x, inputPoint.x*slope + intercept);;
+    return DataPoint<T>(inputPoint.x, predictedValue(inputPoint.x, slope, intercept));
 }
 
 /*
@@ -168,24 +191,30 @@ double LinearRegression<T>::getIntercept() const
 template <typename T>
 double LinearRegression<T>::getMAE() const
 {
-    if (!MAECalculated)
+    if (!MAECalculated) {
+        STATS_COUNT(GetterExceptions, 1);
         throw std::logic_error("MAE no ha sido calculado");
+    }
     return MAE;
 }
 
 template <typename T>
 double LinearRegression<T>::getMSE() const
 {
-    if (!MSECalculated)
+    if (!MSECalculated) {
+        STATS_COUNT(GetterExceptions, 1);
         throw std::logic_error("MSE no ha sido calculado");
+    }
     return MSE;
 }
 
 template <typename T>
 double LinearRegression<T>::getRMSE() const
 {
-    if (!RMSECalculated)
+    if (!RMSECalculated) {
+        STATS_COUNT(GetterExceptions, 1);
         throw std::logic_error("RMSE no ha sido calculado");
+    }
     return RMSE;
 }
 template <typename T>
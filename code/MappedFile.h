@@ -0,0 +1,64 @@
+/*
+ * MappedFile.h
+ * ----------------------
+ * Definición de la clase MappedFile.
+ * Proyecta un archivo completo en memoria de solo lectura (mmap) para que
+ * los lectores de datos recorran sus bytes sin copiarlos.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * Clase MappedFile
+ * ----------------------------
+ * Mantiene la proyección mientras el objeto existe y la libera al destruirse.
+ * En sistemas sin mmap el contenido se lee a un búfer en memoria.
+ */
+class MappedFile {
+public:
+    /*
+     * Constructor de la clase MappedFile
+     * ----------------------------------
+     * Parámetros:
+     *  - string fileName: Ruta del archivo a proyectar.
+     * Lanza std::runtime_error si el archivo no se puede abrir o proyectar, o
+     * si no es un archivo regular (ver isMappableFile).
+     */
+    explicit MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Puntero al primer byte del archivo y tamaño en bytes
+    const char* data() const;
+    std::size_t size() const;
+
+    // Nombre del archivo proyectado, usado en los mensajes de error
+    const std::string& name() const;
+
+private:
+    std::string fileName;
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+    bool mapped = false;       // true si bytes proviene de mmap
+    std::vector<char> buffer;  // Respaldo cuando no hay mmap
+};
+
+/*
+ * Función isMappableFile
+ * ----------------------------
+ * Indica si la ruta se puede proyectar: FIFOs, /dev/stdin y sustituciones de
+ * procesos (<(...)) reportan tamaño 0 y deben leerse como flujo. Retorna true
+ * si la ruta no existe, para que el error lo informe quien la abra.
+ */
+bool isMappableFile(const std::string& fileName);
+
+#include "MappedFile.hxx"
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,108 @@
+/*
+ * MappedFile.hxx
+ * ----------------------
+ * Implementación de la clase MappedFile.
+ * Usa mmap en sistemas POSIX y una lectura completa del archivo en los demás.
+ */
+
+#ifndef MAPPEDFILE_HXX
+#define MAPPEDFILE_HXX
+
+#include "MappedFile.h"
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+/*
+ * Constructor de MappedFile
+ * -------------------------
+ * Abre el archivo, obtiene su tamaño y lo proyecta completo en memoria.
+ */
+inline MappedFile::MappedFile(const std::string& fileName) : fileName(fileName)
+{
+#ifdef MAPPEDFILE_USE_MMAP
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Error al abrir el archivo: " + fileName);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Error al consultar el archivo: " + fileName);
+    }
+    if (!S_ISREG(info.st_mode)) {
+        ::close(fd);
+        throw std::runtime_error("No es un archivo regular y no se puede proyectar: " + fileName);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+
+    if (length > 0) {
+        void* region = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (region == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Error al proyectar el archivo en memoria: " + fileName);
+        }
+        ::madvise(region, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(region);
+        mapped = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream input(fileName, std::ios::binary);
+    if (!input.is_open())
+        throw std::runtime_error("Error al abrir el archivo: " + fileName);
+    buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+#endif
+}
+
+/*
+ * Destructor de MappedFile
+ * ------------------------
+ * Libera la proyección si existe.
+ */
+inline MappedFile::~MappedFile()
+{
+#ifdef MAPPEDFILE_USE_MMAP
+    if (mapped)
+        ::munmap(const_cast<char*>(bytes), length);
+#endif
+}
+
+inline bool isMappableFile(const std::string& fileName)
+{
+#ifdef MAPPEDFILE_USE_MMAP
+    struct stat info;
+    return ::stat(fileName.c_str(), &info) != 0 || S_ISREG(info.st_mode);
+#else
+    (void)fileName;
+    return true; // Sin mmap el contenido se lee con un flujo, que admite cualquier origen
+#endif
+}
+
+inline const char* MappedFile::data() const
+{
+    return bytes;
+}
+
+inline std::size_t MappedFile::size() const
+{
+    return length;
+}
+
+inline const std::string& MappedFile::name() const
+{
+    return fileName;
+}
+
+#endif // MAPPEDFILE_HXX
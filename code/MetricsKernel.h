@@ -0,0 +1,321 @@
+/*
+ * MetricsKernel.h
+ * ----------------------
+ * Núcleo de evaluación fusionado para los modelos de regresión lineal.
+ * Calcula en una sola pasada la suma de errores absolutos y la suma de
+ * errores cuadráticos de un modelo sobre columnas contiguas de x e y.
+ */
+
+#ifndef METRICSKERNEL_H
+#define METRICSKERNEL_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/*
+ * Estructura ResidualSums
+ * ----------------------------
+ * Acumula las sumas de residuos necesarias para obtener MAE, MSE y RMSE.
+ */
+struct ResidualSums {
+    double sumAbsoluteError = 0.0; // Suma de |y - y'|
+    double sumSquaredError = 0.0;  // Suma de (y - y')^2
+};
+
+/*
+ * Plantilla EvaluationTraits
+ * ----------------------------
+ * Elige en tiempo de compilación cómo se evalúan los puntos de tipo T.
+ *  - exactInteger: los datos son enteros (int16, int32, ...); la predicción se
+ *    redondea al entero más cercano, se satura al rango de T y los residuos
+ *    se acumulan como enteros, sin error de redondeo dentro de cada bloque.
+ *  - Accumulator: tipo en el que se calculan y acumulan los residuos de datos
+ *    de punto flotante. float se almacena en float pero se acumula en double,
+ *    salvo que se compile con CODE_FLOAT_ACCUMULATION (más rápido, menos preciso).
+ */
+template <typename T>
+struct EvaluationTraits {
+    static_assert(std::is_arithmetic_v<T>, "DataSet requiere un tipo aritmético");
+    static constexpr bool exactInteger = std::is_integral_v<T>;
+    using Accumulator = double;
+};
+
+#ifdef CODE_FLOAT_ACCUMULATION
+template <>
+struct EvaluationTraits<float> {
+    static constexpr bool exactInteger = false;
+    using Accumulator = float;
+};
+#endif
+
+// Acumulador de los cuadrados de residuos enteros
+#ifdef __SIZEOF_INT128__
+using WideUnsigned = unsigned __int128;
+#else
+using WideUnsigned = long double;
+#endif
+
+// Límite de la predicción redondeada, para que el residuo entero no desborde int64
+const double INTEGER_PREDICTION_LIMIT = 4611686018427387904.0; // 2^62
+
+// Menor y mayor predicción representables en T (acotadas a ±2^62)
+template <typename T>
+constexpr double lowestPrediction()
+{
+    return static_cast<double>(std::numeric_limits<T>::min()) > -INTEGER_PREDICTION_LIMIT
+               ? static_cast<double>(std::numeric_limits<T>::min())
+               : -INTEGER_PREDICTION_LIMIT;
+}
+
+template <typename T>
+constexpr double highestPrediction()
+{
+    return static_cast<double>(std::numeric_limits<T>::max()) < INTEGER_PREDICTION_LIMIT
+               ? static_cast<double>(std::numeric_limits<T>::max())
+               : INTEGER_PREDICTION_LIMIT;
+}
+
+/*
+ * Función roundedPrediction
+ * ----------------------------
+ * Predicción de datos enteros: se redondea al entero más cercano (al par en
+ * los empates) y se satura al rango de T. Es la única definición de la
+ * predicción entera; la usan predict(), residualOf y los núcleos, de modo que
+ * las métricas describen exactamente lo que predict() retorna.
+ */
+template <typename T>
+inline double roundedPrediction(double x, double slope, double intercept)
+{
+    double predicted = std::nearbyint(x * slope + intercept);
+    return std::fmax(lowestPrediction<T>(), std::fmin(highestPrediction<T>(), predicted));
+}
+
+/*
+ * Función predictedValue
+ * ----------------------------
+ * Predicción del modelo (slope, intercept) en x, expresada en T. Para enteros
+ * se usa roundedPrediction en lugar de truncar.
+ */
+template <typename T>
+inline T predictedValue(T x, double slope, double intercept)
+{
+    if constexpr (EvaluationTraits<T>::exactInteger)
+        return static_cast<T>(roundedPrediction<T>(static_cast<double>(x), slope, intercept));
+    else
+        return static_cast<T>(static_cast<double>(x) * slope + intercept);
+}
+
+// Residuo entero y - y' de datos enteros, con y' = roundedPrediction
+template <typename T>
+inline std::int64_t integerResidualOf(T x, T y, double slope, double intercept)
+{
+    return static_cast<std::int64_t>(y) -
+           static_cast<std::int64_t>(roundedPrediction<T>(static_cast<double>(x), slope, intercept));
+}
+
+/*
+ * Función residualOf
+ * ----------------------------
+ * Calcula el residuo y - y' de un punto para el modelo (slope, intercept),
+ * con la misma aritmética que fusedResidualSums usa para T.
+ */
+template <typename T>
+inline double residualOf(T x, T y, double slope, double intercept)
+{
+    if constexpr (EvaluationTraits<T>::exactInteger) {
+        return static_cast<double>(integerResidualOf(x, y, slope, intercept));
+    } else {
+        using A = typename EvaluationTraits<T>::Accumulator;
+        A predicted = static_cast<A>(x) * static_cast<A>(slope) + static_cast<A>(intercept);
+        return static_cast<double>(static_cast<A>(y) - predicted);
+    }
+}
+
+/*
+ * Función fusedResidualSums
+ * ----------------------------
+ * Recorre una sola vez las columnas x e y y acumula ambas sumas de residuos.
+ * Para datos de punto flotante se usan KERNEL_LANES acumuladores
+ * independientes del tipo EvaluationTraits<T>::Accumulator, para que el
+ * compilador pueda vectorizar el bucle (SSE/AVX) sin reordenar sumas.
+ * Para datos enteros las sumas son exactas (carriles double acotados o
+ * enteros de 64 y 128 bits) y se convierten a double una sola vez al final del bloque.
+ *
+ * Parámetros:
+ *  - const T* xs: Columna contigua de coordenadas X.
+ *  - const T* ys: Columna contigua de coordenadas Y.
+ *  - size_t n: Número de puntos.
+ *  - double slope: Pendiente del modelo.
+ *  - double intercept: Ordenada al origen del modelo.
+ */
+const std::size_t KERNEL_LANES = 4;
+
+/*
+ * Ruta rápida de residuos enteros
+ * ----------------------------
+ * Redondea con la suma de 1.5·2^52 (al par más cercano, como nearbyint),
+ * satura al rango de T como roundedPrediction y acumula en KERNEL_LANES
+ * carriles double, lo que el compilador vectoriza. Solo para tipos de hasta
+ * 32 bits: fuera de ±2^51 el redondeo con la constante no es exacto, pero
+ * esas predicciones ya quedan fuera del rango de T y se saturan.
+ * Si todos los |r| son a lo sumo 2^20 y cada carril suma a lo sumo 2^12
+ * puntos, cada suma es un entero menor que 2^53 y por tanto exacta. Retorna
+ * false (sin resultado) si algún residuo excede el límite.
+ */
+const double INTEGER_ROUNDING_MAGIC = 6755399441055744.0; // 1.5 · 2^52
+const double FAST_INTEGER_RESIDUAL_LIMIT = 1048576.0;     // 2^20
+const std::size_t FAST_INTEGER_MAX_POINTS = KERNEL_LANES << 12;
+
+// Convierte un entero a double pasando por int32 cuando cabe, para que el bucle se vectorice
+template <typename T>
+inline double integerToDouble(T value)
+{
+    if constexpr (sizeof(T) < sizeof(std::int32_t) || (std::is_signed_v<T> && sizeof(T) == sizeof(std::int32_t)))
+        return static_cast<double>(static_cast<std::int32_t>(value));
+    else
+        return static_cast<double>(value);
+}
+
+template <typename T>
+bool fastIntegerResidualSums(const T* xs, const T* ys, std::size_t n, double slope, double intercept, ResidualSums& sums)
+{
+    if (sizeof(T) > sizeof(std::int32_t) || n > FAST_INTEGER_MAX_POINTS)
+        return false;
+    const double low = lowestPrediction<T>();
+    const double high = highestPrediction<T>();
+    double absLanes[KERNEL_LANES] = {};
+    double sqLanes[KERNEL_LANES] = {};
+    double maxLanes[KERNEL_LANES] = {};
+
+    std::size_t i = 0;
+    for (; i + KERNEL_LANES <= n; i += KERNEL_LANES) {
+        for (std::size_t lane = 0; lane < KERNEL_LANES; ++lane) {
+            double predicted = integerToDouble(xs[i + lane]) * slope + intercept;
+            double rounded = (predicted + INTEGER_ROUNDING_MAGIC) - INTEGER_ROUNDING_MAGIC;
+            rounded = rounded < low ? low : (rounded > high ? high : rounded);
+            double magnitude = std::fabs(integerToDouble(ys[i + lane]) - rounded);
+            absLanes[lane] += magnitude;
+            sqLanes[lane] += magnitude * magnitude;
+            maxLanes[lane] = maxLanes[lane] < magnitude ? magnitude : maxLanes[lane];
+        }
+    }
+    for (std::size_t lane = 0; i < n; ++i, ++lane) {
+        double predicted = integerToDouble(xs[i]) * slope + intercept;
+        double rounded = (predicted + INTEGER_ROUNDING_MAGIC) - INTEGER_ROUNDING_MAGIC;
+        rounded = rounded < low ? low : (rounded > high ? high : rounded);
+        double magnitude = std::fabs(integerToDouble(ys[i]) - rounded);
+        absLanes[lane] += magnitude;
+        sqLanes[lane] += magnitude * magnitude;
+        maxLanes[lane] = maxLanes[lane] < magnitude ? magnitude : maxLanes[lane];
+    }
+
+    // La comparación negada también descarta NaN, que el máximo no propaga
+    for (std::size_t lane = 0; lane < KERNEL_LANES; ++lane) {
+        if (!(maxLanes[lane] <= FAST_INTEGER_RESIDUAL_LIMIT && sqLanes[lane] < INTEGER_ROUNDING_MAGIC))
+            return false;
+    }
+    // Los carriles son enteros exactos; se suman como enteros y se redondean una sola vez
+    std::uint64_t absolute = 0, squared = 0;
+    for (std::size_t lane = 0; lane < KERNEL_LANES; ++lane) {
+        absolute += static_cast<std::uint64_t>(absLanes[lane]);
+        squared += static_cast<std::uint64_t>(sqLanes[lane]);
+    }
+    sums.sumAbsoluteError = static_cast<double>(absolute);
+    sums.sumSquaredError = static_cast<double>(squared);
+    return true;
+}
+
+template <typename T>
+ResidualSums fusedResidualSums(const T* xs, const T* ys, std::size_t n, double slope, double intercept)
+{
+    ResidualSums sums;
+    if constexpr (EvaluationTraits<T>::exactInteger) {
+        if (fastIntegerResidualSums(xs, ys, n, slope, intercept, sums))
+            return sums;
+        WideUnsigned absolute = 0;
+        WideUnsigned squared = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::int64_t residual = integerResidualOf(xs[i], ys[i], slope, intercept);
+            std::uint64_t magnitude = residual < 0 ? 0 - static_cast<std::uint64_t>(residual)
+                                                   : static_cast<std::uint64_t>(residual);
+            absolute += magnitude;
+            squared += static_cast<WideUnsigned>(magnitude) * magnitude;
+        }
+        sums.sumAbsoluteError = static_cast<double>(absolute);
+        sums.sumSquaredError = static_cast<double>(squared);
+    } else {
+        static_assert(KERNEL_LANES == 4, "La reducción final asume cuatro acumuladores");
+        using A = typename EvaluationTraits<T>::Accumulator;
+        A absLanes[KERNEL_LANES] = {};
+        A sqLanes[KERNEL_LANES] = {};
+        const A m = static_cast<A>(slope);
+        const A b = static_cast<A>(intercept);
+
+        std::size_t i = 0;
+        for (; i + KERNEL_LANES <= n; i += KERNEL_LANES) {
+            for (std::size_t lane = 0; lane < KERNEL_LANES; ++lane) {
+                A residual = static_cast<A>(ys[i + lane]) - (static_cast<A>(xs[i + lane]) * m + b);
+                absLanes[lane] += std::fabs(residual);
+                sqLanes[lane] += residual * residual;
+            }
+        }
+        // Puntos restantes que no completan un bloque
+        for (std::size_t lane = 0; i < n; ++i, ++lane) {
+            A residual = static_cast<A>(ys[i]) - (static_cast<A>(xs[i]) * m + b);
+            absLanes[lane] += std::fabs(residual);
+            sqLanes[lane] += residual * residual;
+        }
+
+        sums.sumAbsoluteError = static_cast<double>((absLanes[0] + absLanes[1]) + (absLanes[2] + absLanes[3]));
+        sums.sumSquaredError = static_cast<double>((sqLanes[0] + sqLanes[1]) + (sqLanes[2] + sqLanes[3]));
+    }
+    return sums;
+}
+
+/*
+ * Reducción por bloques fijos
+ * ----------------------------
+ * Los puntos se dividen en bloques de EVALUATION_CHUNK elementos; cada bloque
+ * se reduce con fusedResidualSums y los parciales se suman en orden de bloque
+ * partiendo de cero. Todas las rutas de evaluación (secuencial o en paralelo)
+ * usan esta misma reducción, por lo que los resultados son idénticos bit a bit
+ * sin importar el número de hilos.
+ */
+const std::size_t EVALUATION_CHUNK = 1 << 14;
+
+// Número de bloques de EVALUATION_CHUNK puntos necesarios para n puntos
+inline std::size_t evaluationChunkCount(std::size_t n)
+{
+    return (n + EVALUATION_CHUNK - 1) / EVALUATION_CHUNK;
+}
+
+// Sumas de residuos del bloque chunk
+template <typename T>
+ResidualSums chunkResidualSums(const T* xs, const T* ys, std::size_t n, std::size_t chunk, double slope, double intercept)
+{
+    std::size_t first = chunk * EVALUATION_CHUNK;
+    std::size_t count = (n - first < EVALUATION_CHUNK) ? n - first : EVALUATION_CHUNK;
+    return fusedResidualSums(xs + first, ys + first, count, slope, intercept);
+}
+
+// Añade un parcial al total; el orden de las llamadas define el resultado
+inline void accumulateResidualSums(ResidualSums& total, const ResidualSums& partial)
+{
+    total.sumAbsoluteError += partial.sumAbsoluteError;
+    total.sumSquaredError += partial.sumSquaredError;
+}
+
+// Reducción canónica de todos los puntos, bloque por bloque y en orden
+template <typename T>
+ResidualSums chunkedResidualSums(const T* xs, const T* ys, std::size_t n, double slope, double intercept)
+{
+    ResidualSums total;
+    for (std::size_t chunk = 0; chunk < evaluationChunkCount(n); ++chunk)
+        accumulateResidualSums(total, chunkResidualSums(xs, ys, n, chunk, slope, intercept));
+    return total;
+}
+
+#endif // METRICSKERNEL_H
@@ -0,0 +1,117 @@
+/*
+ * ModelBank.h
+ * ----------------------
+ * Definición de la clase plantilla ModelBank.
+ * Almacenamiento contiguo (estructura de arreglos) de los coeficientes y las
+ * métricas de todos los modelos de un DataSet, para evaluar y seleccionar
+ * modelos recorriendo memoria secuencial en lugar de los nodos de una lista.
+ */
+
+#ifndef MODELBANK_H
+#define MODELBANK_H
+
+#include "MetricsKernel.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+template <typename T>
+class LinearRegression;
+
+/*
+ * Enumeración Metric
+ * ----------------------------
+ * Métricas de error disponibles. Se usa como parámetro de plantilla para
+ * elegir la métrica en tiempo de compilación.
+ */
+enum class Metric { MAE = 0, MSE = 1, RMSE = 2 };
+
+// Convierte el nombre de una métrica ("MAE", "MSE", "RMSE") en su valor; lanza si no existe
+Metric metricFromName(const std::string& name);
+
+// Nombre de una métrica, para mensajes y reportes
+const char* metricName(Metric metric);
+
+/*
+ * Estructura BestModelIndices
+ * ----------------------------
+ * Posiciones del mejor modelo para cada métrica, obtenidas en una sola pasada.
+ * Vale NO_MODEL para una métrica que no está calculada en todos los modelos.
+ */
+const std::size_t NO_MODEL = static_cast<std::size_t>(-1);
+
+struct BestModelIndices {
+    std::size_t mae;
+    std::size_t mse;
+    std::size_t rmse;
+};
+
+/*
+ * Plantilla de clase ModelBank
+ * ----------------------------
+ * La posición i de cada arreglo corresponde al i-ésimo modelo añadido al DataSet;
+ * el banco es el único almacenamiento de los modelos.
+ * calculated guarda un bit por métrica (1 << Metric) para cada modelo.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class ModelBank {
+public:
+    std::vector<double> slopes;
+    std::vector<double> intercepts;
+    std::vector<double> maeValues;
+    std::vector<double> mseValues;
+    std::vector<double> rmseValues;
+    std::vector<std::uint8_t> calculated;
+
+    // Número de modelos almacenados
+    std::size_t size() const;
+
+    // Añade un modelo sin métricas calculadas
+    void add(double slope, double intercept);
+
+    // Reemplaza los coeficientes del modelo i y marca sus métricas como no calculadas
+    void replace(std::size_t i, double slope, double intercept);
+
+    // Guarda MAE, MSE y RMSE del modelo i a partir de las sumas de residuos de n puntos
+    void store(std::size_t i, const ResidualSums& sums, std::size_t pointCount);
+
+    // Guarda el valor de una métrica del modelo i y la marca como calculada
+    template <Metric M>
+    void setMetric(std::size_t i, double value);
+
+    // Arreglo contiguo con los valores de la métrica M
+    template <Metric M>
+    const std::vector<double>& values() const;
+
+    /*
+     * Método para obtener los k mejores modelos según la métrica M.
+     * ------------------------------------------------------------
+     * Selección parcial en una pasada con un montículo de k elementos: O(P log k).
+     * Retorna:
+     *  - Posiciones de los modelos, del mejor al peor (empates por posición).
+     * Lanza std::logic_error si algún modelo no tiene la métrica calculada.
+     */
+    template <Metric M>
+    std::vector<std::size_t> findTopK(std::size_t k) const;
+
+    /*
+     * Método para obtener el mejor modelo de las tres métricas en una sola pasada.
+     * ------------------------------------------------------------
+     * Empates por posición: gana el primer modelo con el menor valor.
+     */
+    BestModelIndices findBest() const;
+
+    // Crea una copia del modelo i como LinearRegression, con sus métricas y banderas
+    LinearRegression<T> toModel(std::size_t i) const;
+
+private:
+    // Verifica que todos los modelos tengan calculada la métrica M
+    template <Metric M>
+    void requireCalculated() const;
+};
+
+#include "ModelBank.hxx"
+
+#endif // MODELBANK_H
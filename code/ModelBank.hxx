@@ -0,0 +1,186 @@
+/*
+ * ModelBank.hxx
+ * ----------------------
+ * Implementación de la clase plantilla ModelBank.
+ */
+
+#ifndef MODELBANK_HXX
+#define MODELBANK_HXX
+
+#include "ModelBank.h"
+#include "LinearRegression.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+inline Metric metricFromName(const std::string& name)
+{
+    if (name == "MAE")
+        return Metric::MAE;
+    if (name == "MSE")
+        return Metric::MSE;
+    if (name == "RMSE")
+        return Metric::RMSE;
+    throw std::invalid_argument("Métrica no reconocida: " + name);
+}
+
+inline const char* metricName(Metric metric)
+{
+    switch (metric) {
+    case Metric::MAE:
+        return "MAE";
+    case Metric::MSE:
+        return "MSE";
+    default:
+        return "RMSE";
+    }
+}
+
+// Bit de la métrica dentro de ModelBank::calculated
+inline std::uint8_t metricBit(Metric metric)
+{
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(metric));
+}
+
+template <typename T>
+std::size_t ModelBank<T>::size() const
+{
+    return slopes.size();
+}
+
+template <typename T>
+void ModelBank<T>::add(double slope, double intercept)
+{
+    slopes.push_back(slope);
+    intercepts.push_back(intercept);
+    maeValues.push_back(0.0);
+    mseValues.push_back(0.0);
+    rmseValues.push_back(0.0);
+    calculated.push_back(0);
+}
+
+template <typename T>
+void ModelBank<T>::replace(std::size_t i, double slope, double intercept)
+{
+    slopes[i] = slope;
+    intercepts[i] = intercept;
+    calculated[i] = 0;
+}
+
+template <typename T>
+void ModelBank<T>::store(std::size_t i, const ResidualSums& sums, std::size_t pointCount)
+{
+    const double n = static_cast<double>(pointCount);
+    const double mse = sums.sumSquaredError / n;
+    maeValues[i] = sums.sumAbsoluteError / n;
+    mseValues[i] = mse;
+    rmseValues[i] = std::sqrt(mse);
+    calculated[i] = metricBit(Metric::MAE) | metricBit(Metric::MSE) | metricBit(Metric::RMSE);
+}
+
+template <typename T>
+template <Metric M>
+void ModelBank<T>::setMetric(std::size_t i, double value)
+{
+    std::vector<double>& column = M == Metric::MAE ? maeValues : (M == Metric::MSE ? mseValues : rmseValues);
+    column[i] = value;
+    calculated[i] |= metricBit(M);
+}
+
+template <typename T>
+template <Metric M>
+const std::vector<double>& ModelBank<T>::values() const
+{
+    return M == Metric::MAE ? maeValues : (M == Metric::MSE ? mseValues : rmseValues);
+}
+
+template <typename T>
+template <Metric M>
+void ModelBank<T>::requireCalculated() const
+{
+    const std::uint8_t bit = metricBit(M);
+    for (std::size_t i = 0; i < calculated.size(); ++i) {
+        if (!(calculated[i] & bit))
+            throw std::logic_error(std::string(metricName(M)) + " no ha sido calculado");
+    }
+}
+
+/*
+ * Implementación del método findTopK
+ * -----------------------------------
+ * Mantiene en un montículo de máximos los k mejores vistos hasta el momento;
+ * cada modelo nuevo solo entra si mejora al peor de ellos.
+ */
+template <typename T>
+template <Metric M>
+std::vector<std::size_t> ModelBank<T>::findTopK(std::size_t k) const
+{
+    requireCalculated<M>();
+    const std::vector<double>& metric = values<M>();
+    k = std::min(k, metric.size());
+
+    typedef std::pair<double, std::size_t> Candidate;
+    std::vector<Candidate> heap;
+    heap.reserve(k);
+    for (std::size_t i = 0; i < metric.size() && k > 0; ++i) {
+        Candidate candidate(metric[i], i);
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end());
+
+    std::vector<std::size_t> indices(heap.size());
+    for (std::size_t j = 0; j < heap.size(); ++j)
+        indices[j] = heap[j].second;
+    return indices;
+}
+
+/*
+ * Implementación del método findBest
+ * -----------------------------------
+ * Recorre una vez los arreglos de las tres métricas y la máscara de banderas.
+ */
+template <typename T>
+BestModelIndices ModelBank<T>::findBest() const
+{
+    BestModelIndices best = {NO_MODEL, NO_MODEL, NO_MODEL};
+    std::uint8_t common = static_cast<std::uint8_t>(0xFF);
+    for (std::size_t i = 0; i < slopes.size(); ++i) {
+        common &= calculated[i];
+        if (best.mae == NO_MODEL || maeValues[i] < maeValues[best.mae])
+            best.mae = i;
+        if (best.mse == NO_MODEL || mseValues[i] < mseValues[best.mse])
+            best.mse = i;
+        if (best.rmse == NO_MODEL || rmseValues[i] < rmseValues[best.rmse])
+            best.rmse = i;
+    }
+    if (!(common & metricBit(Metric::MAE)))
+        best.mae = NO_MODEL;
+    if (!(common & metricBit(Metric::MSE)))
+        best.mse = NO_MODEL;
+    if (!(common & metricBit(Metric::RMSE)))
+        best.rmse = NO_MODEL;
+    return best;
+}
+
+template <typename T>
+LinearRegression<T> ModelBank<T>::toModel(std::size_t i) const
+{
+    LinearRegression<T> model(slopes[i], intercepts[i]);
+    model.setMAE(maeValues[i]);
+    model.setMSE(mseValues[i]);
+    model.setRMSE(rmseValues[i]);
+    model.setMAECalculated((calculated[i] & metricBit(Metric::MAE)) != 0);
+    model.setMSECalculated((calculated[i] & metricBit(Metric::MSE)) != 0);
+    model.setRMSECalculated((calculated[i] & metricBit(Metric::RMSE)) != 0);
+    return model;
+}
+
+#endif // MODELBANK_HXX
@@ -0,0 +1,109 @@
+/*
+ * MomentIndex.h
+ * ----------------------
+ * Definición de la clase plantilla MomentIndex.
+ * Índice de momentos centrados por bloques (n, x̄, ȳ, Σ(x-x̄)², Σ(x-x̄)(y-ȳ),
+ * Σ(y-ȳ)²) construido sobre los puntos ordenados por x de un DataSet. Permite
+ * obtener el MSE/RMSE de cualquier recta sobre todo el conjunto o sobre un
+ * rango [xLo, xHi] recorriendo a lo sumo dos bloques parciales.
+ */
+
+#ifndef MOMENTINDEX_H
+#define MOMENTINDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class DataSet;
+
+// Puntos por bloque del índice; acota el trabajo directo en los extremos de un rango
+const std::size_t MOMENT_BLOCK = 256;
+
+/*
+ * Plantilla de clase MomentIndex
+ * ----------------------------
+ * Cada bloque de MOMENT_BLOCK puntos guarda sus momentos centrados en su propia
+ * media, y un árbol de segmentos los combina con la fórmula de Chan et al.
+ * Nunca se restan sumas acumuladas: una ventana estrecha lejos del origen
+ * conserva la misma precisión que una cercana. En ventanas anchas y con
+ * rectas que ajustan muy bien, el error relativo es del orden de
+ * ε·m²·Σ(x - x̄)² / Σr², propio de cualquier forma cerrada por momentos.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class MomentIndex {
+public:
+    /*
+     * Método para construir el índice a partir de un conjunto de datos.
+     * ------------------------------------------------------------
+     * Parámetros:
+     *  - const DataSet<T>& dataSet: Conjunto cuyos puntos están ordenados por x.
+     */
+    void build(const DataSet<T>& dataSet);
+
+    // Marca el índice como desactualizado (por ejemplo, tras insertar un punto)
+    void invalidate();
+
+    // Indica si el índice refleja el estado actual del conjunto
+    bool isBuilt() const;
+
+    /*
+     * Método para obtener el rango de índices de los puntos con x en [xLo, xHi].
+     * ------------------------------------------------------------
+     * Búsqueda binaria O(log N) sobre la columna X ordenada.
+     * Retorna:
+     *  - Par [primero, último) de posiciones en el conjunto.
+     */
+    std::pair<std::size_t, std::size_t> rangeOf(const DataSet<T>& dataSet, T xLo, T xHi) const;
+
+    /*
+     * Método para calcular la suma de errores cuadráticos de una recta en un rango.
+     * ------------------------------------------------------------
+     * Los bloques completos del rango se resuelven en forma cerrada con
+     * O(log N) combinaciones; los puntos de los bloques parciales de los
+     * extremos (menos de 2·MOMENT_BLOCK) se evalúan directamente.
+     * Parámetros:
+     *  - const DataSet<T>& dataSet: Conjunto sobre el que se construyó el índice.
+     *  - double slope, double intercept: Coeficientes de la recta.
+     *  - size_t first, size_t last: Rango [first, last) de posiciones.
+     */
+    double sumSquaredError(const DataSet<T>& dataSet, double slope, double intercept, std::size_t first,
+                           std::size_t last) const;
+
+    // Error cuadrático medio de la recta sobre el rango [first, last)
+    double meanSquaredError(const DataSet<T>& dataSet, double slope, double intercept, std::size_t first,
+                            std::size_t last) const;
+
+    // Número de puntos indexados
+    std::size_t size() const;
+
+private:
+    // Momentos de un grupo de puntos, centrados en las medias del propio grupo
+    struct Moments {
+        double count = 0.0;
+        double meanX = 0.0;
+        double meanY = 0.0;
+        double cuu = 0.0;
+        double cuv = 0.0;
+        double cvv = 0.0;
+    };
+
+    bool built = false;
+    std::size_t points = 0;
+    std::size_t blocks = 0;
+
+    // Árbol de segmentos: las hojas (blocks ... 2·blocks) son los bloques y el nodo i combina 2i y 2i+1
+    std::vector<Moments> tree;
+
+    // Combina los momentos de b en a (fórmula de Chan et al.)
+    static void combine(Moments& a, const Moments& b);
+
+    // Momentos combinados de los bloques [firstBlock, lastBlock)
+    Moments blockRange(std::size_t firstBlock, std::size_t lastBlock) const;
+};
+
+#include "MomentIndex.hxx"
+
+#endif // MOMENTINDEX_H
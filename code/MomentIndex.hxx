@@ -0,0 +1,175 @@
+/*
+ * MomentIndex.hxx
+ * ----------------------
+ * Implementación de la clase plantilla MomentIndex.
+ * Aquí se construyen los momentos por bloque y se evalúa el error
+ * cuadrático de una recta en forma cerrada.
+ */
+
+#ifndef MOMENTINDEX_HXX
+#define MOMENTINDEX_HXX
+
+#include "MomentIndex.h"
+#include "DataSet.h"
+#include "MetricsKernel.h"
+#include <algorithm>
+#include <stdexcept>
+
+template <typename T>
+void MomentIndex<T>::combine(Moments& a, const Moments& b)
+{
+    if (b.count == 0.0)
+        return;
+    if (a.count == 0.0) {
+        a = b;
+        return;
+    }
+    const double count = a.count + b.count;
+    const double dx = b.meanX - a.meanX;
+    const double dy = b.meanY - a.meanY;
+    const double weight = a.count * b.count / count;
+    a.cuu += b.cuu + dx * dx * weight;
+    a.cuv += b.cuv + dx * dy * weight;
+    a.cvv += b.cvv + dy * dy * weight;
+    a.meanX += dx * b.count / count;
+    a.meanY += dy * b.count / count;
+    a.count = count;
+}
+
+/*
+ * Implementación del método build
+ * --------------------------------
+ * Cada bloque se centra en su propia media con dos pasadas sobre sus puntos;
+ * luego los nodos internos del árbol combinan a sus hijos. Costo O(N).
+ */
+template <typename T>
+void MomentIndex<T>::build(const DataSet<T>& dataSet)
+{
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    points = dataSet.pointCount();
+    blocks = (points + MOMENT_BLOCK - 1) / MOMENT_BLOCK;
+    tree.assign(2 * blocks, Moments());
+
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t first = b * MOMENT_BLOCK;
+        const std::size_t last = std::min(points, first + MOMENT_BLOCK);
+        Moments& leaf = tree[blocks + b];
+        leaf.count = static_cast<double>(last - first);
+        for (std::size_t i = first; i < last; ++i) {
+            leaf.meanX += static_cast<double>(xs[i]);
+            leaf.meanY += static_cast<double>(ys[i]);
+        }
+        leaf.meanX /= leaf.count;
+        leaf.meanY /= leaf.count;
+        for (std::size_t i = first; i < last; ++i) {
+            double u = static_cast<double>(xs[i]) - leaf.meanX;
+            double v = static_cast<double>(ys[i]) - leaf.meanY;
+            leaf.cuu += u * u;
+            leaf.cuv += u * v;
+            leaf.cvv += v * v;
+        }
+    }
+    for (std::size_t node = blocks; node-- > 1;) {
+        tree[node] = tree[2 * node];
+        combine(tree[node], tree[2 * node + 1]);
+    }
+    built = true;
+}
+
+template <typename T>
+void MomentIndex<T>::invalidate()
+{
+    built = false;
+}
+
+template <typename T>
+bool MomentIndex<T>::isBuilt() const
+{
+    return built;
+}
+
+template <typename T>
+std::size_t MomentIndex<T>::size() const
+{
+    return points;
+}
+
+/*
+ * Implementación del método rangeOf
+ * ----------------------------------
+ * Localiza con búsqueda binaria los puntos cuyo x pertenece a [xLo, xHi].
+ */
+template <typename T>
+std::pair<std::size_t, std::size_t> MomentIndex<T>::rangeOf(const DataSet<T>& dataSet, T xLo, T xHi) const
+{
+    const T* begin = dataSet.xData();
+    const T* end = begin + dataSet.pointCount();
+    const T* first = std::lower_bound(begin, end, xLo);
+    const T* last = std::upper_bound(first, end, xHi);
+    return std::make_pair(static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - begin));
+}
+
+template <typename T>
+typename MomentIndex<T>::Moments MomentIndex<T>::blockRange(std::size_t firstBlock, std::size_t lastBlock) const
+{
+    Moments left, right;
+    for (std::size_t lo = firstBlock + blocks, hi = lastBlock + blocks; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1)
+            combine(left, tree[lo++]);
+        if (hi & 1)
+            combine(right, tree[--hi]);
+    }
+    combine(left, right);
+    return left;
+}
+
+/*
+ * Implementación del método sumSquaredError
+ * ------------------------------------------
+ * Para los bloques completos, con r = y - (m·x + b) y los momentos centrados
+ * del grupo:
+ *   Σr² = (Cvv - 2m·Cuv + m²·Cuu) + n·(ȳ - m·x̄ - b)²
+ * Los puntos de los extremos que no llenan un bloque se evalúan con
+ * residualOf. La predicción no se trunca a T.
+ */
+template <typename T>
+double MomentIndex<T>::sumSquaredError(const DataSet<T>& dataSet, double slope, double intercept, std::size_t first,
+                                       std::size_t last) const
+{
+    if (!built)
+        throw std::logic_error("El índice de momentos no ha sido construido");
+    if (first >= last)
+        throw std::runtime_error("No hay puntos en el rango solicitado");
+
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    auto direct = [&](std::size_t from, std::size_t to) {
+        double sum = 0.0;
+        for (std::size_t i = from; i < to; ++i) {
+            double residual = residualOf(xs[i], ys[i], slope, intercept);
+            sum += residual * residual;
+        }
+        return sum;
+    };
+
+    const std::size_t firstBlock = (first + MOMENT_BLOCK - 1) / MOMENT_BLOCK;
+    const std::size_t lastBlock = last / MOMENT_BLOCK;
+    if (firstBlock >= lastBlock)
+        return direct(first, last);
+
+    const Moments moments = blockRange(firstBlock, lastBlock);
+    const double centered = moments.cvv - 2.0 * slope * moments.cuv + slope * slope * moments.cuu;
+    const double meanResidual = moments.meanY - slope * moments.meanX - intercept;
+    return std::max(0.0, centered) + moments.count * meanResidual * meanResidual
+         + direct(first, firstBlock * MOMENT_BLOCK) + direct(lastBlock * MOMENT_BLOCK, last);
+}
+
+template <typename T>
+double MomentIndex<T>::meanSquaredError(const DataSet<T>& dataSet, double slope, double intercept, std::size_t first,
+                                        std::size_t last) const
+{
+    return sumSquaredError(dataSet, slope, intercept, first, last) / static_cast<double>(last - first);
+}
+
+#endif // MOMENTINDEX_HXX
@@ -0,0 +1,64 @@
+/*
+ * ParallelEvaluator.h
+ * ----------------------
+ * Definición de la clase plantilla ParallelEvaluator.
+ * Motor de evaluación multihilo de los modelos de un DataSet. Reparte el
+ * trabajo entre modelos cuando hay muchos, o entre bloques de puntos cuando
+ * hay pocos modelos y muchos puntos, y combina los parciales en un orden fijo.
+ */
+
+#ifndef PARALLELEVALUATOR_H
+#define PARALLELEVALUATOR_H
+
+#include "DataSet.h"
+#include "MetricsKernel.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <vector>
+
+/*
+ * Plantilla de clase ParallelEvaluator
+ * ----------------------------
+ * Usa la reducción por bloques de MetricsKernel.h, de modo que MAE, MSE y
+ * RMSE son idénticos bit a bit a los de la evaluación secuencial para
+ * cualquier número de hilos. Los resultados se escriben en el banco de
+ * modelos del conjunto.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class ParallelEvaluator {
+public:
+    /*
+     * Constructor de la clase ParallelEvaluator
+     * ----------------------------------
+     * Parámetros:
+     *  - ThreadPool& pool: Grupo de hilos que ejecuta las tareas.
+     */
+    explicit ParallelEvaluator(ThreadPool& pool);
+
+    /*
+     * Método para evaluar todos los modelos del conjunto de datos.
+     * ------------------------------------------------------------
+     * Lanza una excepción si el conjunto de datos está vacío.
+     */
+    void evaluate(DataSet<T>& dataSet);
+
+    /*
+     * Método para calcular las sumas de residuos de algunos modelos del banco.
+     * ------------------------------------------------------------
+     * Mismo reparto y misma reducción por bloques que evaluate, sin guardar
+     * métricas. Lo usa la eliminación sucesiva para evaluar los finalistas.
+     * Parámetros:
+     *  - vector<size_t> models: Posiciones de los modelos en el banco.
+     * Retorna:
+     *  - Sumas de cada modelo sobre todos los puntos, en el orden de models.
+     */
+    std::vector<ResidualSums> residualSums(const DataSet<T>& dataSet, const std::vector<std::size_t>& models);
+
+private:
+    ThreadPool& pool;
+};
+
+#include "ParallelEvaluator.hxx"
+
+#endif // PARALLELEVALUATOR_H
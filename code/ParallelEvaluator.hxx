@@ -0,0 +1,92 @@
+/*
+ * ParallelEvaluator.hxx
+ * ----------------------
+ * Implementación de la clase plantilla ParallelEvaluator.
+ */
+
+#ifndef PARALLELEVALUATOR_HXX
+#define PARALLELEVALUATOR_HXX
+
+#include "ParallelEvaluator.h"
+#include "MetricsKernel.h"
+#include "Stats.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+template <typename T>
+ParallelEvaluator<T>::ParallelEvaluator(ThreadPool& pool) : pool(pool) {}
+
+/*
+ * Implementación del método evaluate
+ * -----------------------------------
+ * Evalúa todos los modelos del banco con residualSums y guarda sus métricas.
+ */
+template <typename T>
+void ParallelEvaluator<T>::evaluate(DataSet<T>& dataSet)
+{
+    const std::size_t n = dataSet.pointCount();
+    if (n == 0)
+        throw std::runtime_error("El conjunto de datos está vacío");
+    STATS_TIMER(Evaluate);
+
+    ModelBank<T>& bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * n);
+    std::vector<std::size_t> models(bank.size());
+    for (std::size_t m = 0; m < models.size(); ++m)
+        models[m] = m;
+    std::vector<ResidualSums> sums = residualSums(dataSet, models);
+    for (std::size_t m = 0; m < models.size(); ++m)
+        bank.store(m, sums[m], n);
+}
+
+/*
+ * Implementación del método residualSums
+ * ---------------------------------------
+ * Con suficientes modelos para ocupar todos los hilos, cada tarea evalúa un
+ * grupo de modelos completos. Si no, cada tarea evalúa un bloque de puntos de
+ * un modelo, guarda su parcial y al final los parciales de cada modelo se
+ * suman en orden de bloque. En ambos casos la suma es la misma que la de
+ * chunkedResidualSums. Los coeficientes se leen del banco de modelos.
+ */
+template <typename T>
+std::vector<ResidualSums> ParallelEvaluator<T>::residualSums(const DataSet<T>& dataSet,
+                                                             const std::vector<std::size_t>& models)
+{
+    const std::size_t n = dataSet.pointCount();
+    const ModelBank<T>& bank = dataSet.modelBank;
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    const std::size_t P = models.size();
+    const std::size_t chunks = evaluationChunkCount(n);
+    const std::size_t lanes = pool.size() + 1;
+    std::vector<ResidualSums> sums(P);
+    if (P == 0)
+        return sums;
+
+    if (P >= 4 * lanes || chunks == 1) {
+        // Paralelismo entre modelos: grupos de modelos por tarea
+        const std::size_t tasks = std::min(P, 8 * lanes);
+        pool.parallelFor(tasks, [&](std::size_t task) {
+            std::size_t first = P * task / tasks;
+            std::size_t last = P * (task + 1) / tasks;
+            for (std::size_t j = first; j < last; ++j)
+                sums[j] = chunkedResidualSums(xs, ys, n, bank.slopes[models[j]], bank.intercepts[models[j]]);
+        });
+        return sums;
+    }
+
+    // Paralelismo entre bloques de puntos: un parcial por (modelo, bloque)
+    std::vector<ResidualSums> partials(P * chunks);
+    pool.parallelFor(P * chunks, [&](std::size_t task) {
+        std::size_t j = task / chunks;
+        std::size_t chunk = task % chunks;
+        partials[task] = chunkResidualSums(xs, ys, n, chunk, bank.slopes[models[j]], bank.intercepts[models[j]]);
+    });
+    for (std::size_t j = 0; j < P; ++j)
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+            accumulateResidualSums(sums[j], partials[j * chunks + chunk]);
+    return sums;
+}
+
+#endif // PARALLELEVALUATOR_HXX
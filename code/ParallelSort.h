@@ -0,0 +1,71 @@
+/*
+ * ParallelSort.h
+ * ----------------------
+ * Ordenamiento estable en paralelo para la carga masiva de puntos.
+ * Divide el arreglo en bloques, ordena cada bloque en su propio hilo y
+ * luego mezcla los bloques adyacentes por rondas.
+ */
+
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Tamaño mínimo a partir del cual conviene repartir el ordenamiento entre hilos
+const std::size_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+/*
+ * Función parallelStableSort
+ * ----------------------------
+ * Ordena de forma estable el vector según el comparador dado.
+ * Para vectores pequeños o con un solo hilo permitido usa std::stable_sort.
+ *
+ * Parámetros:
+ *  - std::vector<E>& values: Elementos a ordenar.
+ *  - Compare less: Comparador estricto.
+ *  - size_t maxThreads: Máximo de hilos a usar, el llamador incluido.
+ */
+template <typename E, typename Compare>
+void parallelStableSort(std::vector<E>& values, Compare less, std::size_t maxThreads)
+{
+    std::size_t workers = maxThreads;
+    if (values.size() < PARALLEL_SORT_THRESHOLD || workers <= 1) {
+        std::stable_sort(values.begin(), values.end(), less);
+        return;
+    }
+    workers = std::min(workers, values.size() / (PARALLEL_SORT_THRESHOLD / 4));
+
+    // Límites de los bloques: bounds[k] .. bounds[k + 1]
+    std::vector<std::size_t> bounds(workers + 1);
+    for (std::size_t k = 0; k <= workers; ++k)
+        bounds[k] = values.size() * k / workers;
+
+    std::vector<std::thread> threads;
+    for (std::size_t k = 0; k < workers; ++k) {
+        threads.emplace_back([&values, &bounds, less, k]() {
+            std::stable_sort(values.begin() + bounds[k], values.begin() + bounds[k + 1], less);
+        });
+    }
+    for (std::size_t k = 0; k < threads.size(); ++k)
+        threads[k].join();
+
+    // Mezcla por rondas de bloques adyacentes; mezclar en orden conserva la estabilidad
+    for (std::size_t width = 1; width < workers; width *= 2) {
+        threads.clear();
+        for (std::size_t k = 0; k + width < workers; k += 2 * width) {
+            std::size_t begin = bounds[k];
+            std::size_t middle = bounds[k + width];
+            std::size_t end = bounds[std::min(k + 2 * width, workers)];
+            threads.emplace_back([&values, less, begin, middle, end]() {
+                std::inplace_merge(values.begin() + begin, values.begin() + middle, values.begin() + end, less);
+            });
+        }
+        for (std::size_t k = 0; k < threads.size(); ++k)
+            threads[k].join();
+    }
+}
+
+#endif // PARALLELSORT_H
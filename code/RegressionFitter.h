@@ -0,0 +1,117 @@
+/*
+ * RegressionFitter.h
+ * ----------------------
+ * Definición de la clase plantilla RegressionFitter.
+ * Ajuste directo de la recta óptima de un DataSet, sin recorrer una rejilla de
+ * modelos candidatos: mínimos cuadrados (óptimo de MSE y RMSE) y mínima
+ * desviación absoluta (óptimo de MAE).
+ */
+
+#ifndef REGRESSIONFITTER_H
+#define REGRESSIONFITTER_H
+
+#include "ModelBank.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+template <typename T>
+class DataSet;
+
+template <typename T>
+class LinearRegression;
+
+/*
+ * Plantilla de clase RegressionFitter
+ * ----------------------------
+ * Los modelos retornados ya traen MAE, MSE y RMSE calculados con la misma
+ * reducción por bloques que evaluateModels, de modo que se pueden añadir a
+ * un DataSet con addModel y compararse con los demás modelos.
+ * Las rectas minimizan el error con predicciones reales; con datos enteros la
+ * evaluación redondea la predicción y el valor guardado puede diferir un poco
+ * del óptimo continuo.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class RegressionFitter {
+public:
+    /*
+     * Constructor de la clase RegressionFitter
+     * ----------------------------------
+     * Parámetros:
+     *  - ThreadPool* pool: Grupo de hilos para recorrer los puntos en paralelo (nullptr = secuencial).
+     */
+    explicit RegressionFitter(ThreadPool* pool = nullptr);
+
+    /*
+     * Método para ajustar la recta de mínimos cuadrados ordinarios.
+     * ------------------------------------------------------------
+     * Una sola pasada paralela sobre los puntos: cada bloque calcula sus
+     * medias y sumas centradas, y los bloques se combinan en orden (Chan et
+     * al.), así el resultado no depende del número de hilos.
+     * Lanza std::runtime_error si el conjunto de datos está vacío.
+     */
+    LinearRegression<T> fitLeastSquares(DataSet<T>& dataSet);
+
+    /*
+     * Método para ajustar la recta de mínima desviación absoluta.
+     * ------------------------------------------------------------
+     * Descenso de Wesolowsky: la recta óptima pasa por al menos dos puntos;
+     * partiendo de un punto pivote, la mejor pendiente entre las rectas que
+     * lo contienen es una mediana ponderada (O(N log N)), y el punto que la
+     * define pasa a ser el siguiente pivote hasta que la recta deja de mejorar.
+     * Costo O(iteraciones · N log N); las iteraciones suelen ser pocas y se
+     * acotan en LAD_MAX_ITERATIONS.
+     * Lanza std::runtime_error si el conjunto de datos está vacío o si el
+     * descenso no converge dentro de ese límite.
+     */
+    LinearRegression<T> fitLeastAbsoluteDeviations(DataSet<T>& dataSet);
+
+    // Ajusta la recta óptima para la métrica: LAD para MAE, mínimos cuadrados para MSE y RMSE
+    LinearRegression<T> fit(DataSet<T>& dataSet, Metric metric);
+
+private:
+    /*
+     * Estructura Moments
+     * ----------------------------
+     * Número de puntos, medias y sumas centradas Σ(x - x̄)² y Σ(x - x̄)(y - ȳ).
+     */
+    struct Moments {
+        double count = 0.0;
+        double meanX = 0.0;
+        double meanY = 0.0;
+        double sxx = 0.0;
+        double sxy = 0.0;
+    };
+
+    ThreadPool* pool;
+
+    // Momentos de los puntos [first, last), desplazados por el primero para evitar cancelación
+    static Moments chunkMoments(const T* xs, const T* ys, std::size_t first, std::size_t last);
+
+    // Combina los momentos de b en a (fórmula de Chan et al.)
+    static void combine(Moments& a, const Moments& b);
+
+    // Pendiente y ordenada de mínimos cuadrados, sin evaluar el modelo
+    void leastSquaresCoefficients(const DataSet<T>& dataSet, double& slope, double& intercept);
+
+    // Suma de |y - (intercept + slope·x)| con predicciones reales, para el descenso LAD
+    double absoluteDeviation(const T* xs, const T* ys, std::size_t n, double slope, double intercept);
+
+    /*
+     * Busca un punto de la recta sobre el que girarla reduzca la desviación.
+     * Retorna n si no hay ninguno, es decir, si la recta es óptima.
+     */
+    std::size_t descentPivot(const T* xs, const T* ys, std::size_t n, double slope, double intercept);
+
+    // Crea el modelo y calcula sus métricas sobre todos los puntos
+    LinearRegression<T> evaluated(const DataSet<T>& dataSet, double slope, double intercept);
+
+    // Aplica body(i) a cada i en [0, count), en paralelo si hay grupo de hilos
+    void forEach(std::size_t count, const std::function<void(std::size_t)>& body);
+};
+
+#include "RegressionFitter.hxx"
+
+#endif // REGRESSIONFITTER_H
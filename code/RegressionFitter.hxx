@@ -0,0 +1,328 @@
+/*
+ * RegressionFitter.hxx
+ * ----------------------
+ * Implementación de la clase plantilla RegressionFitter.
+ */
+
+#ifndef REGRESSIONFITTER_HXX
+#define REGRESSIONFITTER_HXX
+
+#include "RegressionFitter.h"
+#include "DataSet.h"
+#include "MetricsKernel.h"
+#include "Stats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Máximo de cambios de pivote del descenso LAD; en la práctica converge en pocos.
+// Si se agota, el ajuste se rechaza en lugar de retornar una recta no óptima
+const std::size_t LAD_MAX_ITERATIONS = 200;
+
+// Tolerancia relativa para considerar un residuo nulo o una derivada negativa
+const double LAD_RELATIVE_TOLERANCE = 1e-12;
+
+template <typename T>
+RegressionFitter<T>::RegressionFitter(ThreadPool* pool) : pool(pool) {}
+
+template <typename T>
+void RegressionFitter<T>::forEach(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (pool) {
+        pool->parallelFor(count, body);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        body(i);
+}
+
+template <typename T>
+typename RegressionFitter<T>::Moments RegressionFitter<T>::chunkMoments(const T* xs, const T* ys, std::size_t first,
+                                                                        std::size_t last)
+{
+    Moments moments;
+    if (first == last)
+        return moments;
+    // Los puntos están ordenados por x, así el primero del bloque está cerca de su media
+    const double x0 = static_cast<double>(xs[first]);
+    const double y0 = static_cast<double>(ys[first]);
+    double su = 0.0, sv = 0.0, suu = 0.0, suv = 0.0;
+    for (std::size_t i = first; i < last; ++i) {
+        double u = static_cast<double>(xs[i]) - x0;
+        double v = static_cast<double>(ys[i]) - y0;
+        su += u;
+        sv += v;
+        suu += u * u;
+        suv += u * v;
+    }
+    const double count = static_cast<double>(last - first);
+    moments.count = count;
+    moments.meanX = x0 + su / count;
+    moments.meanY = y0 + sv / count;
+    moments.sxx = suu - su * su / count;
+    moments.sxy = suv - su * sv / count;
+    return moments;
+}
+
+template <typename T>
+void RegressionFitter<T>::combine(Moments& a, const Moments& b)
+{
+    if (b.count == 0.0)
+        return;
+    if (a.count == 0.0) {
+        a = b;
+        return;
+    }
+    const double count = a.count + b.count;
+    const double dx = b.meanX - a.meanX;
+    const double dy = b.meanY - a.meanY;
+    const double weight = a.count * b.count / count;
+    a.sxx += b.sxx + dx * dx * weight;
+    a.sxy += b.sxy + dx * dy * weight;
+    a.meanX += dx * b.count / count;
+    a.meanY += dy * b.count / count;
+    a.count = count;
+}
+
+/*
+ * Implementación del método leastSquaresCoefficients
+ * ---------------------------------------------------
+ * Los bloques son los mismos de la evaluación (EVALUATION_CHUNK puntos) y se
+ * combinan en orden de bloque. Si todos los x son iguales la pendiente no está
+ * determinada y se usa la recta horizontal en la media de y.
+ */
+template <typename T>
+void RegressionFitter<T>::leastSquaresCoefficients(const DataSet<T>& dataSet, double& slope, double& intercept)
+{
+    const std::size_t n = dataSet.pointCount();
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    const std::size_t chunks = evaluationChunkCount(n);
+
+    std::vector<Moments> partials(chunks);
+    forEach(chunks, [&](std::size_t chunk) {
+        std::size_t first = chunk * EVALUATION_CHUNK;
+        partials[chunk] = chunkMoments(xs, ys, first, std::min(n, first + EVALUATION_CHUNK));
+    });
+    Moments total;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        combine(total, partials[chunk]);
+
+    slope = total.sxx > 0.0 ? total.sxy / total.sxx : 0.0;
+    intercept = total.meanY - slope * total.meanX;
+}
+
+template <typename T>
+LinearRegression<T> RegressionFitter<T>::fitLeastSquares(DataSet<T>& dataSet)
+{
+    if (dataSet.pointCount() == 0)
+        throw std::runtime_error("El conjunto de datos está vacío");
+    STATS_TIMER(Select);
+
+    double slope = 0.0, intercept = 0.0;
+    leastSquaresCoefficients(dataSet, slope, intercept);
+    return evaluated(dataSet, slope, intercept);
+}
+
+template <typename T>
+double RegressionFitter<T>::absoluteDeviation(const T* xs, const T* ys, std::size_t n, double slope, double intercept)
+{
+    const std::size_t chunks = evaluationChunkCount(n);
+    std::vector<double> partials(chunks);
+    forEach(chunks, [&](std::size_t chunk) {
+        std::size_t last = std::min(n, (chunk + 1) * EVALUATION_CHUNK);
+        double sum = 0.0;
+        for (std::size_t i = chunk * EVALUATION_CHUNK; i < last; ++i)
+            sum += std::fabs(static_cast<double>(ys[i]) - (static_cast<double>(xs[i]) * slope + intercept));
+        partials[chunk] = sum;
+    });
+    double total = 0.0;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        total += partials[chunk];
+    return total;
+}
+
+/*
+ * Implementación del método descentPivot
+ * ---------------------------------------
+ * Al girar la recta sobre el punto l con pendiente creciente, cada residuo no
+ * nulo cambia a razón de -signo(r_i)·(x_i - x_l) y cada punto sobre la recta
+ * a razón de |x_i - x_l|. Con A = Σ signo(r_i)·x_i y B = Σ signo(r_i), las
+ * derivadas en ambos sentidos son ∓(A - x_l·B) + Σ |x_i - x_l|; la última
+ * suma se obtiene para todos los puntos sobre la recta con sumas prefijas.
+ * Los bordes de las regiones lineales de la desviación que pasan por la recta
+ * son exactamente esos giros, así que si ninguno desciende la recta es óptima.
+ */
+template <typename T>
+std::size_t RegressionFitter<T>::descentPivot(const T* xs, const T* ys, std::size_t n, double slope, double intercept)
+{
+    std::vector<std::pair<double, std::size_t>> onLine;
+    double signedX = 0.0, signedCount = 0.0, scale = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double x = static_cast<double>(xs[i]);
+        double y = static_cast<double>(ys[i]);
+        double residual = y - (x * slope + intercept);
+        double tolerance = LAD_RELATIVE_TOLERANCE * (std::fabs(y) + std::fabs(x * slope) + std::fabs(intercept));
+        if (std::fabs(residual) <= tolerance) {
+            onLine.push_back(std::make_pair(x, i));
+        } else {
+            signedX += residual > 0.0 ? x : -x;
+            signedCount += residual > 0.0 ? 1.0 : -1.0;
+        }
+        scale += std::fabs(x);
+    }
+
+    std::sort(onLine.begin(), onLine.end());
+    std::vector<double> prefix(onLine.size() + 1, 0.0);
+    for (std::size_t p = 0; p < onLine.size(); ++p)
+        prefix[p + 1] = prefix[p] + onLine[p].first;
+
+    const double count = static_cast<double>(onLine.size());
+    for (std::size_t p = 0; p < onLine.size(); ++p) {
+        double x = onLine[p].first;
+        double below = x * static_cast<double>(p) - prefix[p];
+        double above = (prefix[onLine.size()] - prefix[p + 1]) - x * (count - static_cast<double>(p) - 1.0);
+        double tilt = signedX - x * signedCount;
+        if (std::min(below + above - tilt, below + above + tilt) < -LAD_RELATIVE_TOLERANCE * scale)
+            return onLine[p].second;
+    }
+    return n;
+}
+
+/*
+ * Implementación del método fitLeastAbsoluteDeviations
+ * ------------------------------------------------------
+ * Con pivote k, la desviación de las rectas que pasan por k es
+ * Σ |x_i - x_k| · |s_i - b|, con s_i la pendiente de k a i; la mínima es la
+ * mediana de las s_i ponderada por |x_i - x_k|. La recta nueva pasa por k y
+ * por el punto de la mediana, que es el siguiente pivote. Cuando girar sobre
+ * el nuevo pivote ya no reduce la desviación, la recta es óptima al girar
+ * sobre sus dos puntos y, por convexidad, en todo el plano de coeficientes.
+ * Si más de dos puntos quedan sobre la recta eso no basta, y descentPivot
+ * elige otro de ellos para seguir descendiendo.
+ * El pivote inicial es el punto más cercano a la recta de mínimos cuadrados.
+ */
+template <typename T>
+LinearRegression<T> RegressionFitter<T>::fitLeastAbsoluteDeviations(DataSet<T>& dataSet)
+{
+    const std::size_t n = dataSet.pointCount();
+    if (n == 0)
+        throw std::runtime_error("El conjunto de datos está vacío");
+    STATS_TIMER(Select);
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+
+    double slope = 0.0, intercept = 0.0;
+    leastSquaresCoefficients(dataSet, slope, intercept);
+    std::size_t pivot = 0;
+    double closest = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < n; ++i) {
+        double distance = std::fabs(static_cast<double>(ys[i]) - (static_cast<double>(xs[i]) * slope + intercept));
+        if (distance < closest) {
+            closest = distance;
+            pivot = i;
+        }
+    }
+
+    // Pendiente hacia cada punto con x distinto del pivote, su peso y su posición
+    struct Candidate {
+        double slope;
+        double weight;
+        std::size_t index;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(n);
+    double bestDeviation = std::numeric_limits<double>::infinity();
+    bool converged = false;
+
+    for (std::size_t iteration = 0; iteration < LAD_MAX_ITERATIONS; ++iteration) {
+        const double px = static_cast<double>(xs[pivot]);
+        const double py = static_cast<double>(ys[pivot]);
+        candidates.clear();
+        double totalWeight = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            double dx = static_cast<double>(xs[i]) - px;
+            if (dx == 0.0)
+                continue;
+            candidates.push_back(Candidate{(static_cast<double>(ys[i]) - py) / dx, std::fabs(dx), i});
+            totalWeight += std::fabs(dx);
+        }
+
+        if (candidates.empty()) {
+            // Todos los x son iguales: la recta horizontal en la mediana de y
+            std::vector<double> values(ys, ys + n);
+            std::nth_element(values.begin(), values.begin() + (n - 1) / 2, values.end());
+            return evaluated(dataSet, 0.0, values[(n - 1) / 2]);
+        }
+
+        // Empates por posición para que el pivote siguiente no dependa del algoritmo de orden
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.slope < b.slope || (a.slope == b.slope && a.index < b.index);
+        });
+        std::size_t median = 0;
+        double cumulative = candidates[0].weight;
+        while (cumulative < totalWeight / 2.0 && median + 1 < candidates.size())
+            cumulative += candidates[++median].weight;
+
+        double candidateSlope = candidates[median].slope;
+        double candidateIntercept = py - candidateSlope * px;
+        double deviation = absoluteDeviation(xs, ys, n, candidateSlope, candidateIntercept);
+        if (!(deviation < bestDeviation)) {
+            std::size_t next = descentPivot(xs, ys, n, slope, intercept);
+            if (next == n || next == pivot) {
+                converged = true;
+                break;
+            }
+            pivot = next;
+            continue;
+        }
+        bestDeviation = deviation;
+        slope = candidateSlope;
+        intercept = candidateIntercept;
+        pivot = candidates[median].index;
+    }
+
+    if (!converged)
+        throw std::runtime_error("El ajuste por mínima desviación absoluta no convergió en " +
+                                 std::to_string(LAD_MAX_ITERATIONS) + " cambios de pivote");
+    return evaluated(dataSet, slope, intercept);
+}
+
+template <typename T>
+LinearRegression<T> RegressionFitter<T>::fit(DataSet<T>& dataSet, Metric metric)
+{
+    return metric == Metric::MAE ? fitLeastAbsoluteDeviations(dataSet) : fitLeastSquares(dataSet);
+}
+
+/*
+ * Implementación del método evaluated
+ * ------------------------------------
+ * Un parcial por bloque, sumados en orden: las mismas sumas que
+ * chunkedResidualSums con cualquier número de hilos.
+ */
+template <typename T>
+LinearRegression<T> RegressionFitter<T>::evaluated(const DataSet<T>& dataSet, double slope, double intercept)
+{
+    const std::size_t n = dataSet.pointCount();
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    const std::size_t chunks = evaluationChunkCount(n);
+    STATS_COUNT(ModelPointEvaluations, n);
+
+    std::vector<ResidualSums> partials(chunks);
+    forEach(chunks, [&](std::size_t chunk) {
+        partials[chunk] = chunkResidualSums(xs, ys, n, chunk, slope, intercept);
+    });
+    ResidualSums total;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        accumulateResidualSums(total, partials[chunk]);
+
+    LinearRegression<T> model(slope, intercept);
+    model.storeMetrics(total, n);
+    return model;
+}
+
+#endif // REGRESSIONFITTER_HXX
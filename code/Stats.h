@@ -0,0 +1,93 @@
+/*
+ * Stats.h
+ * ----------------------
+ * Instrumentación de las rutas críticas: temporizadores por fase, contadores
+ * de eventos y memoria residente máxima, reportados con la opción --stats.
+ * Solo se compila si CODE_STATS está definido; en otro caso las macros no
+ * generan código y sus argumentos no se evalúan.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#ifdef CODE_STATS
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/*
+ * Enumeraciones StatPhase y StatCounter
+ * ----------------------------
+ * Fases cronometradas y contadores disponibles. Los tiempos son inclusivos:
+ * una fase que se ejecuta dentro de otra (por ejemplo Insert durante Parse)
+ * se suma en ambas. Insert solo cronometra la confirmación de lotes; las
+ * inserciones individuales se cuentan pero su tiempo queda en la fase que
+ * las invoca.
+ */
+enum class StatPhase { Parse, Insert, Evaluate, Select, Output, Count };
+enum class StatCounter { PointsInserted, InsertShifts, ModelPointEvaluations, GetterExceptions, Count };
+
+/*
+ * Clase Stats
+ * ----------------------------
+ * Registro global del proceso. Los contadores son atómicos con orden relajado,
+ * de modo que los hilos del evaluador en paralelo pueden sumar sin bloqueo.
+ */
+class Stats {
+public:
+    static Stats& instance();
+
+    void add(StatCounter counter, std::uint64_t amount);
+    void addTime(StatPhase phase, std::uint64_t nanoseconds);
+
+    // Escribe el reporte como JSON o como texto legible
+    void writeJson(std::ostream& out) const;
+    void writeText(std::ostream& out) const;
+
+private:
+    std::atomic<std::uint64_t> counters[static_cast<std::size_t>(StatCounter::Count)];
+    std::atomic<std::uint64_t> phaseNanoseconds[static_cast<std::size_t>(StatPhase::Count)];
+    std::atomic<std::uint64_t> phaseCalls[static_cast<std::size_t>(StatPhase::Count)];
+
+    Stats();
+};
+
+/*
+ * Clase ScopedTimer
+ * ----------------------------
+ * Suma a la fase el tiempo transcurrido entre su construcción y su destrucción.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(StatPhase phase);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    StatPhase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Memoria residente máxima del proceso en bytes; 0 si no está disponible
+long long peakResidentMemory();
+
+#define STATS_CONCAT_INNER(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_INNER(a, b)
+#define STATS_TIMER(phase) ScopedTimer STATS_CONCAT(statsTimer, __LINE__)(StatPhase::phase)
+#define STATS_COUNT(counter, amount) Stats::instance().add(StatCounter::counter, static_cast<std::uint64_t>(amount))
+
+#include "Stats.hxx"
+
+#else
+
+#define STATS_TIMER(phase) ((void)0)
+#define STATS_COUNT(counter, amount) ((void)0)
+
+#endif // CODE_STATS
+
+#endif // STATS_H
@@ -0,0 +1,102 @@
+/*
+ * Stats.hxx
+ * ----------------------
+ * Implementación del registro de estadísticas y del temporizador por ámbito.
+ */
+
+#ifndef STATS_HXX
+#define STATS_HXX
+
+#include "Stats.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STATS_USE_RUSAGE 1
+#include <sys/resource.h>
+#endif
+
+static const char* const STAT_PHASE_NAMES[] = {"parse", "insert", "evaluate", "select", "output"};
+static const char* const STAT_COUNTER_NAMES[] = {"points_inserted", "insert_shifts", "model_point_evaluations",
+                                                 "getter_exceptions"};
+
+inline Stats::Stats()
+{
+    for (std::atomic<std::uint64_t>& counter : counters)
+        counter.store(0, std::memory_order_relaxed);
+    for (std::size_t p = 0; p < static_cast<std::size_t>(StatPhase::Count); ++p) {
+        phaseNanoseconds[p].store(0, std::memory_order_relaxed);
+        phaseCalls[p].store(0, std::memory_order_relaxed);
+    }
+}
+
+inline Stats& Stats::instance()
+{
+    static Stats stats;
+    return stats;
+}
+
+inline void Stats::add(StatCounter counter, std::uint64_t amount)
+{
+    counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+inline void Stats::addTime(StatPhase phase, std::uint64_t nanoseconds)
+{
+    phaseNanoseconds[static_cast<std::size_t>(phase)].fetch_add(nanoseconds, std::memory_order_relaxed);
+    phaseCalls[static_cast<std::size_t>(phase)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void Stats::writeJson(std::ostream& out) const
+{
+    out << "{\"phases\": {";
+    for (std::size_t p = 0; p < static_cast<std::size_t>(StatPhase::Count); ++p) {
+        out << (p ? ", " : "") << '"' << STAT_PHASE_NAMES[p] << "\": {\"seconds\": "
+            << static_cast<double>(phaseNanoseconds[p].load(std::memory_order_relaxed)) * 1e-9
+            << ", \"calls\": " << phaseCalls[p].load(std::memory_order_relaxed) << '}';
+    }
+    out << "}, \"counters\": {";
+    for (std::size_t c = 0; c < static_cast<std::size_t>(StatCounter::Count); ++c) {
+        out << (c ? ", " : "") << '"' << STAT_COUNTER_NAMES[c] << "\": "
+            << counters[c].load(std::memory_order_relaxed);
+    }
+    out << "}, \"peak_rss_bytes\": " << peakResidentMemory() << "}\n";
+}
+
+inline void Stats::writeText(std::ostream& out) const
+{
+    out << "Estadisticas:\n";
+    for (std::size_t p = 0; p < static_cast<std::size_t>(StatPhase::Count); ++p) {
+        out << "  " << STAT_PHASE_NAMES[p] << ": "
+            << static_cast<double>(phaseNanoseconds[p].load(std::memory_order_relaxed)) * 1e-9 << " s en "
+            << phaseCalls[p].load(std::memory_order_relaxed) << " llamadas\n";
+    }
+    for (std::size_t c = 0; c < static_cast<std::size_t>(StatCounter::Count); ++c)
+        out << "  " << STAT_COUNTER_NAMES[c] << ": " << counters[c].load(std::memory_order_relaxed) << "\n";
+    out << "  peak_rss: " << static_cast<double>(peakResidentMemory()) / (1024.0 * 1024.0) << " MiB\n";
+}
+
+inline ScopedTimer::ScopedTimer(StatPhase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+
+inline ScopedTimer::~ScopedTimer()
+{
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+    Stats::instance().addTime(phase, static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+inline long long peakResidentMemory()
+{
+#ifdef STATS_USE_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<long long>(usage.ru_maxrss);        // macOS informa bytes
+#else
+    return static_cast<long long>(usage.ru_maxrss) * 1024; // Linux informa kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+#endif // STATS_HXX
@@ -0,0 +1,74 @@
+/*
+ * StreamingMetrics.h
+ * ----------------------
+ * Definición de la clase plantilla StreamingMetrics.
+ * Mantiene, para cada modelo de un DataSet, las sumas acumuladas de errores
+ * absolutos y cuadráticos de los puntos de la ventana actual, de modo que
+ * añadir o expulsar un punto cueste O(P) en lugar de reevaluar O(N·P).
+ */
+
+#ifndef STREAMINGMETRICS_H
+#define STREAMINGMETRICS_H
+
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class DataSet;
+
+/*
+ * Plantilla de clase StreamingMetrics
+ * ----------------------------
+ * Las sumas usan suma compensada de Neumaier. Como restar contribuciones de
+ * puntos expulsados acumula error con el tiempo, las sumas se recalculan
+ * desde cero cada vez que el número de expulsiones alcanza el tamaño de la
+ * ventana: el costo amortizado sigue siendo O(P) por punto.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class StreamingMetrics {
+public:
+    // Recalcula las sumas de todos los modelos sobre los puntos actuales
+    void rebuild(const DataSet<T>& dataSet);
+
+    // Suma la contribución del punto (x, y) a cada modelo
+    void addPoint(const DataSet<T>& dataSet, T x, T y);
+
+    // Añade las sumas de un modelo nuevo, calculadas sobre los puntos actuales
+    void appendModel(const DataSet<T>& dataSet, double slope, double intercept);
+
+    // Recalcula las sumas del modelo i, cuyos coeficientes cambiaron, sobre los puntos actuales
+    void replaceModel(const DataSet<T>& dataSet, std::size_t i);
+
+    // Resta la contribución del punto expulsado (x, y) de cada modelo
+    void removePoint(const DataSet<T>& dataSet, T x, T y);
+
+    // Indica si las sumas deben recalcularse para acotar el error acumulado
+    bool needsRefresh(std::size_t pointCount) const;
+
+    // Escribe MAE, MSE y RMSE actuales de cada modelo en el banco del conjunto
+    void publish(DataSet<T>& dataSet) const;
+
+    // Número de modelos con sumas acumuladas
+    std::size_t modelCount() const;
+
+private:
+    struct CompensatedSum {
+        double sum = 0.0;
+        double compensation = 0.0;
+        void add(double value);
+        double value() const;
+    };
+
+    struct ModelSums {
+        CompensatedSum absoluteError;
+        CompensatedSum squaredError;
+    };
+
+    std::vector<ModelSums> sums;       // Una entrada por modelo, en el orden del banco
+    std::size_t removalsSinceRebuild = 0;
+};
+
+#include "StreamingMetrics.hxx"
+
+#endif // STREAMINGMETRICS_H
@@ -0,0 +1,143 @@
+/*
+ * StreamingMetrics.hxx
+ * ----------------------
+ * Implementación de la clase plantilla StreamingMetrics.
+ */
+
+#ifndef STREAMINGMETRICS_HXX
+#define STREAMINGMETRICS_HXX
+
+#include "StreamingMetrics.h"
+#include "DataSet.h"
+#include "MetricsKernel.h"
+#include "Stats.h"
+#include <algorithm>
+#include <cmath>
+
+// Tamaño mínimo de ventana usado para decidir cuándo recalcular las sumas
+const std::size_t STREAMING_MIN_REFRESH = 1024;
+
+/*
+ * Implementación de CompensatedSum
+ * ---------------------------------
+ * Suma de Neumaier: conserva en compensation los bits perdidos en cada suma.
+ */
+template <typename T>
+void StreamingMetrics<T>::CompensatedSum::add(double term)
+{
+    double total = sum + term;
+    if (std::fabs(sum) >= std::fabs(term))
+        compensation += (sum - total) + term;
+    else
+        compensation += (term - total) + sum;
+    sum = total;
+}
+
+template <typename T>
+double StreamingMetrics<T>::CompensatedSum::value() const
+{
+    // Las sumas de errores nunca son negativas; se corrige el ruido de redondeo.
+    // La comparación conserva NaN (std::max lo convertiría en 0)
+    double total = sum + compensation;
+    return total < 0.0 ? 0.0 : total;
+}
+
+/*
+ * Implementación del método rebuild
+ * ----------------------------------
+ * Reevalúa cada modelo con la reducción por bloques y reinicia las compensaciones.
+ */
+template <typename T>
+void StreamingMetrics<T>::rebuild(const DataSet<T>& dataSet)
+{
+    const ModelBank<T>& bank = dataSet.modelBank;
+    sums.assign(bank.size(), ModelSums());
+    removalsSinceRebuild = 0;
+    STATS_COUNT(ModelPointEvaluations, bank.size() * dataSet.pointCount());
+    for (std::size_t m = 0; m < bank.size(); ++m) {
+        ResidualSums total = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                                 bank.slopes[m], bank.intercepts[m]);
+        sums[m].absoluteError.sum = total.sumAbsoluteError;
+        sums[m].squaredError.sum = total.sumSquaredError;
+    }
+}
+
+template <typename T>
+void StreamingMetrics<T>::appendModel(const DataSet<T>& dataSet, double slope, double intercept)
+{
+    ResidualSums total = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(), slope, intercept);
+    STATS_COUNT(ModelPointEvaluations, dataSet.pointCount());
+    ModelSums model;
+    model.absoluteError.sum = total.sumAbsoluteError;
+    model.squaredError.sum = total.sumSquaredError;
+    sums.push_back(model);
+}
+
+template <typename T>
+void StreamingMetrics<T>::replaceModel(const DataSet<T>& dataSet, std::size_t i)
+{
+    const ModelBank<T>& bank = dataSet.modelBank;
+    ResidualSums total = chunkedResidualSums(dataSet.xData(), dataSet.yData(), dataSet.pointCount(),
+                                             bank.slopes[i], bank.intercepts[i]);
+    STATS_COUNT(ModelPointEvaluations, dataSet.pointCount());
+    sums[i] = ModelSums();
+    sums[i].absoluteError.sum = total.sumAbsoluteError;
+    sums[i].squaredError.sum = total.sumSquaredError;
+}
+
+template <typename T>
+void StreamingMetrics<T>::addPoint(const DataSet<T>& dataSet, T x, T y)
+{
+    const ModelBank<T>& bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size());
+    for (std::size_t m = 0; m < bank.size(); ++m) {
+        double residual = residualOf(x, y, bank.slopes[m], bank.intercepts[m]);
+        sums[m].absoluteError.add(std::fabs(residual));
+        sums[m].squaredError.add(residual * residual);
+    }
+}
+
+template <typename T>
+void StreamingMetrics<T>::removePoint(const DataSet<T>& dataSet, T x, T y)
+{
+    const ModelBank<T>& bank = dataSet.modelBank;
+    STATS_COUNT(ModelPointEvaluations, bank.size());
+    for (std::size_t m = 0; m < bank.size(); ++m) {
+        double residual = residualOf(x, y, bank.slopes[m], bank.intercepts[m]);
+        sums[m].absoluteError.add(-std::fabs(residual));
+        sums[m].squaredError.add(-(residual * residual));
+    }
+    ++removalsSinceRebuild;
+}
+
+template <typename T>
+bool StreamingMetrics<T>::needsRefresh(std::size_t pointCount) const
+{
+    return removalsSinceRebuild >= std::max(pointCount, STREAMING_MIN_REFRESH);
+}
+
+template <typename T>
+std::size_t StreamingMetrics<T>::modelCount() const
+{
+    return sums.size();
+}
+
+/*
+ * Implementación del método publish
+ * ----------------------------------
+ * Asigna las métricas actuales de cada modelo en el banco.
+ */
+template <typename T>
+void StreamingMetrics<T>::publish(DataSet<T>& dataSet) const
+{
+    if (dataSet.pointCount() == 0)
+        return;
+    for (std::size_t m = 0; m < sums.size(); ++m) {
+        ResidualSums current;
+        current.sumAbsoluteError = sums[m].absoluteError.value();
+        current.sumSquaredError = sums[m].squaredError.value();
+        dataSet.modelBank.store(m, current, dataSet.pointCount());
+    }
+}
+
+#endif // STREAMINGMETRICS_HXX
@@ -0,0 +1,110 @@
+/*
+ * SuccessiveHalving.h
+ * ----------------------
+ * Definición de la clase plantilla SuccessiveHalving.
+ * Selección aproximada del mejor modelo: evalúa todos los modelos sobre una
+ * muestra de puntos, descarta los que con alta confianza son peores y repite
+ * con muestras cada vez mayores; solo los finalistas ven todos los puntos.
+ */
+
+#ifndef SUCCESSIVEHALVING_H
+#define SUCCESSIVEHALVING_H
+
+#include "ModelBank.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+template <typename T>
+class DataSet;
+
+template <typename T>
+class ParallelEvaluator;
+
+/*
+ * Estructura HalvingOptions
+ * ----------------------------
+ *  - tolerance: error relativo admitido; el modelo elegido tiene un valor
+ *    exacto de la métrica a lo sumo (1 + tolerance) veces el del mejor.
+ *  - failureProbability: probabilidad admitida de que los intervalos de
+ *    confianza fallen y la garantía anterior no se cumpla.
+ *  - keepFraction: fracción de modelos que se busca conservar en cada ronda;
+ *    el tamaño de la muestra crece en 1 / keepFraction por ronda.
+ *  - initialSample: puntos de la primera ronda.
+ *  - seed: semilla del muestreo.
+ */
+struct HalvingOptions {
+    double tolerance = 0.0;
+    double failureProbability = 0.01;
+    double keepFraction = 0.5;
+    std::size_t initialSample = 1024;
+    std::uint64_t seed = 1;
+};
+
+/*
+ * Estructura HalvingResult
+ * ----------------------------
+ * Mejor modelo encontrado y trabajo realizado, en evaluaciones modelo·punto.
+ * value es el valor exacto de la métrica del modelo elegido, calculado sobre
+ * todos los puntos con la misma reducción que evaluateModels.
+ */
+struct HalvingResult {
+    std::size_t best = NO_MODEL;
+    double value = 0.0;
+    std::size_t rounds = 0;
+    std::size_t finalists = 0;
+    std::uint64_t evaluations = 0;
+    std::uint64_t exhaustiveEvaluations = 0;
+    std::uint64_t savedEvaluations = 0;
+};
+
+/*
+ * Plantilla de clase SuccessiveHalving
+ * ----------------------------
+ * Cada ronda toma una muestra estratificada por x (un punto al azar en cada
+ * uno de n tramos iguales) y estima, para cada modelo sobreviviente, la media
+ * de la pérdida (|r| para MAE, r² para MSE y RMSE) con un intervalo de
+ * confianza normal. Un modelo se descarta solo si queda fuera de la fracción
+ * keepFraction de los mejores y su cota inferior supera la menor cota
+ * superior menos la parte de la tolerancia asignada a la ronda.
+ * T es el tipo de dato de los puntos almacenados (por ejemplo: int, float, double).
+ */
+template <typename T>
+class SuccessiveHalving {
+public:
+    /*
+     * Constructor de la clase SuccessiveHalving
+     * ----------------------------------
+     * Parámetros:
+     *  - HalvingOptions options: Parámetros de la selección.
+     *  - ThreadPool* pool: Grupo de hilos para evaluar los modelos en paralelo (nullptr = secuencial).
+     */
+    explicit SuccessiveHalving(const HalvingOptions& options, ThreadPool* pool = nullptr);
+
+    /*
+     * Método para seleccionar el mejor modelo según la métrica.
+     * ------------------------------------------------------------
+     * No modifica las métricas guardadas en los modelos ni en el banco.
+     * Lanza std::runtime_error si no hay puntos o no hay modelos.
+     */
+    HalvingResult select(DataSet<T>& dataSet, Metric metric);
+
+private:
+    // Media y varianza muestral de la pérdida de un modelo en la ronda actual
+    struct Estimate {
+        double mean;
+        double variance;
+    };
+
+    HalvingOptions options;
+    ThreadPool* pool;
+
+    // Aplica body(i) a cada i en [0, count), en paralelo si hay grupo de hilos
+    void forEach(std::size_t count, const std::function<void(std::size_t)>& body);
+};
+
+#include "SuccessiveHalving.hxx"
+
+#endif // SUCCESSIVEHALVING_H
@@ -0,0 +1,203 @@
+/*
+ * SuccessiveHalving.hxx
+ * ----------------------
+ * Implementación de la clase plantilla SuccessiveHalving.
+ */
+
+#ifndef SUCCESSIVEHALVING_HXX
+#define SUCCESSIVEHALVING_HXX
+
+#include "SuccessiveHalving.h"
+#include "DataSet.h"
+#include "MetricsKernel.h"
+#include "ParallelEvaluator.h"
+#include "Stats.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+// Modelos por tarea al estimar en paralelo
+const std::size_t HALVING_MODELS_PER_TASK = 64;
+
+template <typename T>
+SuccessiveHalving<T>::SuccessiveHalving(const HalvingOptions& options, ThreadPool* pool)
+    : options(options), pool(pool)
+{
+    if (!(this->options.keepFraction > 0.0 && this->options.keepFraction < 1.0))
+        throw std::invalid_argument("keepFraction debe estar entre 0 y 1");
+    if (!(this->options.failureProbability > 0.0 && this->options.failureProbability < 1.0))
+        throw std::invalid_argument("failureProbability debe estar entre 0 y 1");
+    if (!(this->options.tolerance >= 0.0))
+        throw std::invalid_argument("La tolerancia no puede ser negativa");
+}
+
+template <typename T>
+void SuccessiveHalving<T>::forEach(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (pool) {
+        pool->parallelFor(count, body);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        body(i);
+}
+
+/*
+ * Implementación del método select
+ * ---------------------------------
+ * Tamaños de muestra: initialSample, creciendo en 1 / keepFraction mientras
+ * no alcancen la mitad de los puntos; después los finalistas se evalúan sobre
+ * todos los puntos. La tolerancia se reparte en partes iguales entre las
+ * rondas, porque un descarte en cada ronda puede perder hasta su parte.
+ *
+ * Garantía: si el modelo m se descarta, el líder (menor cota superior) sigue
+ * vivo y su valor es menor que el de m más la parte de la ronda. El nivel de
+ * confianza usa la cota de Bonferroni sobre todos los intervalos de todas las
+ * rondas; la varianza de la muestra aleatoria simple acota la de la
+ * estratificada. Los intervalos suponen normalidad de la media muestral.
+ */
+template <typename T>
+HalvingResult SuccessiveHalving<T>::select(DataSet<T>& dataSet, Metric metric)
+{
+    const std::size_t N = dataSet.pointCount();
+    if (N == 0)
+        throw std::runtime_error("El conjunto de datos está vacío");
+    const ModelBank<T>& bank = dataSet.modelBank;
+    const std::size_t P = bank.size();
+    if (P == 0)
+        throw std::runtime_error("No hay modelos disponibles para evaluar.");
+    STATS_TIMER(Select);
+
+    const bool squared = metric != Metric::MAE;
+    // RMSE ordena igual que MSE; su tolerancia relativa se traslada al cuadrado
+    const double relativeTolerance = metric == Metric::RMSE
+        ? (1.0 + options.tolerance) * (1.0 + options.tolerance) - 1.0
+        : options.tolerance;
+
+    std::vector<std::size_t> sampleSizes;
+    for (double n = static_cast<double>(std::max<std::size_t>(2, options.initialSample));
+         n < static_cast<double>(N) / 2.0; n = std::ceil(n / options.keepFraction))
+        sampleSizes.push_back(static_cast<std::size_t>(n));
+    const double rounds = static_cast<double>(std::max<std::size_t>(1, sampleSizes.size()));
+
+    HalvingResult result;
+    result.exhaustiveEvaluations = static_cast<std::uint64_t>(P) * N;
+    std::vector<std::size_t> survivors(P);
+    for (std::size_t m = 0; m < P; ++m)
+        survivors[m] = m;
+
+    const T* xs = dataSet.xData();
+    const T* ys = dataSet.yData();
+    std::mt19937_64 random(options.seed);
+    std::vector<T> sampleX;
+    std::vector<T> sampleY;
+    std::vector<Estimate> estimates;
+
+    for (std::size_t r = 0; r < sampleSizes.size() && survivors.size() > 1; ++r) {
+        // Muestra estratificada: un punto al azar en cada tramo de N / n puntos
+        const std::size_t n = sampleSizes[r];
+        sampleX.resize(n);
+        sampleY.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t lo = static_cast<std::size_t>(static_cast<std::uint64_t>(i) * N / n);
+            std::size_t hi = static_cast<std::size_t>(static_cast<std::uint64_t>(i + 1) * N / n);
+            std::size_t index = lo + static_cast<std::size_t>(random() % (hi - lo));
+            sampleX[i] = xs[index];
+            sampleY[i] = ys[index];
+        }
+
+        // Media y varianza de la pérdida, desplazadas por la primera pérdida para evitar cancelación
+        const std::size_t S = survivors.size();
+        estimates.resize(S);
+        std::size_t tasks = (S + HALVING_MODELS_PER_TASK - 1) / HALVING_MODELS_PER_TASK;
+        forEach(tasks, [&](std::size_t task) {
+            std::size_t last = std::min(S, (task + 1) * HALVING_MODELS_PER_TASK);
+            for (std::size_t j = task * HALVING_MODELS_PER_TASK; j < last; ++j) {
+                double slope = bank.slopes[survivors[j]];
+                double intercept = bank.intercepts[survivors[j]];
+                double shift = 0.0, sum = 0.0, sumSquares = 0.0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    double residual = residualOf(sampleX[i], sampleY[i], slope, intercept);
+                    double loss = squared ? residual * residual : std::fabs(residual);
+                    if (i == 0)
+                        shift = loss;
+                    double centered = loss - shift;
+                    sum += centered;
+                    sumSquares += centered * centered;
+                }
+                double mean = sum / static_cast<double>(n);
+                double variance = (sumSquares - sum * mean) / static_cast<double>(n - 1);
+                estimates[j].mean = shift + mean;
+                estimates[j].variance = std::max(0.0, variance);
+            }
+        });
+        result.evaluations += static_cast<std::uint64_t>(S) * n;
+        ++result.rounds;
+
+        // Intervalos de confianza con corrección por población finita
+        const double z = std::sqrt(2.0 * std::log(std::max(1.0, 2.0 * static_cast<double>(S) * rounds / options.failureProbability)));
+        const double finite = std::sqrt(std::max(0.0, 1.0 - static_cast<double>(n) / static_cast<double>(N)));
+        std::vector<double> lower(S), upper(S);
+        std::size_t leader = 0;
+        double minLower = 0.0;
+        for (std::size_t j = 0; j < S; ++j) {
+            double halfWidth = z * std::sqrt(estimates[j].variance / static_cast<double>(n)) * finite;
+            lower[j] = estimates[j].mean - halfWidth;
+            upper[j] = estimates[j].mean + halfWidth;
+            if (upper[j] < upper[leader])
+                leader = j;
+            if (j == 0 || lower[j] < minLower)
+                minLower = lower[j];
+        }
+        // minLower acota por debajo el valor del mejor modelo, así la holgura es relativa a él
+        const double slack = relativeTolerance / rounds * std::max(0.0, minLower);
+
+        // Umbral de la fracción que se busca conservar, según la media estimada
+        std::size_t keepCount = std::max<std::size_t>(1, static_cast<std::size_t>(
+            std::ceil(options.keepFraction * static_cast<double>(S))));
+        std::vector<double> means(S);
+        for (std::size_t j = 0; j < S; ++j)
+            means[j] = estimates[j].mean;
+        std::nth_element(means.begin(), means.begin() + (keepCount - 1), means.end());
+        const double threshold = means[keepCount - 1];
+
+        std::vector<std::size_t> next;
+        next.reserve(S);
+        for (std::size_t j = 0; j < S; ++j) {
+            bool confidentlyWorse = lower[j] > upper[leader] - slack;
+            if (j == leader || estimates[j].mean <= threshold || !confidentlyWorse)
+                next.push_back(survivors[j]);
+        }
+        survivors.swap(next);
+    }
+
+    // Los finalistas se evalúan sobre todos los puntos con la reducción canónica,
+    // en paralelo con el mismo reparto que runEvaluation si hay grupo de hilos
+    result.finalists = survivors.size();
+    std::vector<ResidualSums> finalSums;
+    if (pool) {
+        finalSums = ParallelEvaluator<T>(*pool).residualSums(dataSet, survivors);
+    } else {
+        for (std::size_t j = 0; j < survivors.size(); ++j)
+            finalSums.push_back(chunkedResidualSums(xs, ys, N, bank.slopes[survivors[j]], bank.intercepts[survivors[j]]));
+    }
+    for (std::size_t j = 0; j < survivors.size(); ++j) {
+        std::size_t m = survivors[j];
+        const ResidualSums& sums = finalSums[j];
+        double value = (squared ? sums.sumSquaredError : sums.sumAbsoluteError) / static_cast<double>(N);
+        if (metric == Metric::RMSE)
+            value = std::sqrt(value);
+        if (result.best == NO_MODEL || value < result.value) {
+            result.best = m;
+            result.value = value;
+        }
+    }
+    result.evaluations += static_cast<std::uint64_t>(survivors.size()) * N;
+    result.savedEvaluations = result.exhaustiveEvaluations > result.evaluations
+        ? result.exhaustiveEvaluations - result.evaluations : 0;
+    STATS_COUNT(ModelPointEvaluations, result.evaluations);
+    return result;
+}
+
+#endif // SUCCESSIVEHALVING_HXX
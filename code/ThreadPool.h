@@ -0,0 +1,77 @@
+/*
+ * ThreadPool.h
+ * ----------------------
+ * Definición de la clase ThreadPool.
+ * Conjunto fijo de hilos con una cola de tareas por hilo y robo de trabajo:
+ * cada hilo toma tareas del final de su propia cola y, cuando se vacía,
+ * roba del inicio de las colas de los demás.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Clase ThreadPool
+ * ----------------------------
+ * El hilo que llama a parallelFor también ejecuta tareas mientras espera,
+ * por lo que un grupo de n hilos usa n + 1 núcleos como máximo.
+ */
+class ThreadPool {
+public:
+    /*
+     * Constructor de la clase ThreadPool
+     * ----------------------------------
+     * Parámetros:
+     *  - size_t threadCount: Número de hilos de trabajo (0 = núcleos disponibles).
+     */
+    explicit ThreadPool(std::size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Número de hilos de trabajo
+    std::size_t size() const;
+
+    /*
+     * Método para ejecutar body(i) para cada i en [0, count).
+     * ------------------------------------------------------------
+     * Reparte los índices entre las colas de los hilos y espera a que terminen.
+     * Si alguna tarea lanza una excepción, se relanza la primera en el llamador.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<std::size_t> queuedTasks;
+    bool stopping = false;
+
+    // Bucle principal de cada hilo de trabajo
+    void workerLoop(std::size_t self);
+
+    // Intenta ejecutar una tarea propia o robada; retorna false si no encontró ninguna
+    bool runOneTask(std::size_t self);
+};
+
+#include "ThreadPool.hxx"
+
+#endif // THREADPOOL_H
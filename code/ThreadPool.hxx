@@ -0,0 +1,145 @@
+/*
+ * ThreadPool.hxx
+ * ----------------------
+ * Implementación de la clase ThreadPool.
+ */
+
+#ifndef THREADPOOL_HXX
+#define THREADPOOL_HXX
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+/*
+ * Constructor de ThreadPool
+ * -------------------------
+ * Crea una cola por hilo más una para el hilo llamador y arranca los hilos.
+ */
+inline ThreadPool::ThreadPool(std::size_t threadCount) : queuedTasks(0)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i <= threadCount; ++i)
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+/*
+ * Destructor de ThreadPool
+ * ------------------------
+ * Despierta a todos los hilos para que terminen y los espera.
+ */
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+}
+
+inline std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+/*
+ * Implementación del método runOneTask
+ * -------------------------------------
+ * Toma la última tarea de la cola propia; si está vacía, roba la primera
+ * tarea de la siguiente cola no vacía.
+ */
+inline bool ThreadPool::runOneTask(std::size_t self)
+{
+    std::function<void()> task;
+    for (std::size_t k = 0; k < queues.size() && !task; ++k) {
+        WorkerQueue& queue = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (k == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task)
+        return false;
+    queuedTasks.fetch_sub(1);
+    task();
+    return true;
+}
+
+/*
+ * Implementación del método workerLoop
+ * -------------------------------------
+ * Ejecuta tareas mientras haya y duerme cuando no queda trabajo en ninguna cola.
+ */
+inline void ThreadPool::workerLoop(std::size_t self)
+{
+    for (;;) {
+        if (runOneTask(self))
+            continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || queuedTasks.load() > 0; });
+        if (stopping)
+            return;
+    }
+}
+
+/*
+ * Implementación del método parallelFor
+ * --------------------------------------
+ * Reparte los índices en orden circular entre las colas. El llamador usa la
+ * última cola y ayuda a vaciar las demás hasta que todas las tareas terminan.
+ */
+inline void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (count == 0)
+        return;
+    if (workers.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    std::atomic<std::size_t> remaining(count);
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    // El contador se publica antes que las tareas para que nunca quede por debajo de cero
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(count);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        WorkerQueue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back([&body, &remaining, &errorMutex, &firstError, i]() {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> errorLock(errorMutex);
+                if (!firstError)
+                    firstError = std::current_exception();
+            }
+            remaining.fetch_sub(1);
+        });
+    }
+    wakeUp.notify_all();
+
+    const std::size_t self = queues.size() - 1;
+    while (remaining.load() > 0) {
+        if (!runOneTask(self))
+            std::this_thread::yield();
+    }
+    if (firstError)
+        std::rethrow_exception(firstError);
+}
+
+#endif // THREADPOOL_HXX
@@ -0,0 +1,74 @@
+/*
+ * BenchmarkReport.h
+ * ----------------------
+ * Definición de las utilidades de medición de las pruebas de rendimiento:
+ * cronometraje de repeticiones, percentiles de latencia, memoria residente
+ * máxima del proceso y reporte en JSON.
+ */
+
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Estructura BenchmarkResult
+ * ----------------------------
+ * Resultado de un caso de prueba.
+ *  - work: unidades de trabajo por repetición (puntos·modelos, puntos o bytes).
+ *  - unit: nombre de la unidad de trabajo, usado en el reporte.
+ *  - samples: latencias medidas en segundos (una por repetición u operación).
+ *  - peakRssBytes: memoria residente máxima del proceso al terminar el caso.
+ */
+struct BenchmarkResult {
+    std::string name;
+    std::string type;
+    std::size_t points = 0;
+    std::size_t models = 0;
+    double work = 0.0;
+    std::string unit;
+    std::vector<double> samples;
+    long long peakRssBytes = 0;
+};
+
+// Percentil p (entre 0 y 100) de las muestras, con interpolación lineal
+double percentile(std::vector<double> samples, double p);
+
+// Memoria residente máxima del proceso en bytes (getrusage); 0 si no está disponible
+long long peakResidentBytes();
+
+// Segundos transcurridos según un reloj monótono
+double monotonicSeconds();
+
+/*
+ * Clase BenchmarkReport
+ * ----------------------------
+ * Acumula los resultados y los escribe como un documento JSON con la
+ * configuración de la corrida y un objeto por caso.
+ */
+class BenchmarkReport {
+public:
+    // Añade un parámetro de la corrida al objeto "config" del reporte
+    void setConfig(const std::string& key, const std::string& value);
+    void setConfig(const std::string& key, double value);
+
+    void add(const BenchmarkResult& result);
+
+    // Escribe el reporte completo en JSON
+    void writeJson(std::ostream& out) const;
+
+    // Escribe una línea de resumen legible de un resultado
+    static void writeSummary(std::ostream& out, const BenchmarkResult& result);
+
+private:
+    std::vector<std::pair<std::string, std::string>> config; // Valores ya codificados en JSON
+    std::vector<BenchmarkResult> results;
+};
+
+#include "BenchmarkReport.hxx"
+
+#endif // BENCHMARKREPORT_H
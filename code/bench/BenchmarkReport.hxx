@@ -0,0 +1,146 @@
+/*
+ * BenchmarkReport.hxx
+ * ----------------------
+ * Implementación de las utilidades de medición de las pruebas de rendimiento.
+ */
+
+#ifndef BENCHMARKREPORT_HXX
+#define BENCHMARKREPORT_HXX
+
+#include "BenchmarkReport.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BENCHMARK_USE_RUSAGE 1
+#include <sys/resource.h>
+#endif
+
+inline double percentile(std::vector<double> samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    double rank = p / 100.0 * static_cast<double>(samples.size() - 1);
+    std::size_t lower = static_cast<std::size_t>(std::floor(rank));
+    std::size_t upper = std::min(lower + 1, samples.size() - 1);
+    double fraction = rank - static_cast<double>(lower);
+    return samples[lower] + (samples[upper] - samples[lower]) * fraction;
+}
+
+inline long long peakResidentBytes()
+{
+#ifdef BENCHMARK_USE_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<long long>(usage.ru_maxrss);        // macOS informa bytes
+#else
+    return static_cast<long long>(usage.ru_maxrss) * 1024; // Linux informa kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+inline double monotonicSeconds()
+{
+    typedef std::chrono::steady_clock Clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+// Escapa una cadena para incluirla entre comillas en JSON
+inline std::string jsonString(const std::string& text)
+{
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+// Número en JSON con precisión suficiente para comparar corridas; NaN e infinito como null
+inline std::string jsonNumber(double value)
+{
+    if (!std::isfinite(value))
+        return "null";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+inline void BenchmarkReport::setConfig(const std::string& key, const std::string& value)
+{
+    config.push_back(std::make_pair(key, jsonString(value)));
+}
+
+inline void BenchmarkReport::setConfig(const std::string& key, double value)
+{
+    config.push_back(std::make_pair(key, jsonNumber(value)));
+}
+
+inline void BenchmarkReport::add(const BenchmarkResult& result)
+{
+    results.push_back(result);
+}
+
+/*
+ * Implementación del método writeJson
+ * ------------------------------------
+ * El rendimiento se calcula con la mediana de las latencias para que una
+ * repetición atípica no altere la comparación entre corridas.
+ */
+inline void BenchmarkReport::writeJson(std::ostream& out) const
+{
+    out << "{\n  \"config\": {";
+    for (std::size_t i = 0; i < config.size(); ++i)
+        out << (i ? ", " : "") << jsonString(config[i].first) << ": " << config[i].second;
+    out << "},\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        double median = percentile(r.samples, 50.0);
+        out << (i ? "," : "") << "\n    {"
+            << "\"name\": " << jsonString(r.name)
+            << ", \"type\": " << jsonString(r.type)
+            << ", \"points\": " << r.points
+            << ", \"models\": " << r.models
+            << ", \"samples\": " << r.samples.size()
+            << ", \"unit\": " << jsonString(r.unit)
+            << ", \"work\": " << jsonNumber(r.work)
+            << ", \"throughput\": " << jsonNumber(median > 0.0 ? r.work / median : 0.0)
+            << ", \"latency_seconds\": {"
+            << "\"min\": " << jsonNumber(percentile(r.samples, 0.0))
+            << ", \"p50\": " << jsonNumber(median)
+            << ", \"p90\": " << jsonNumber(percentile(r.samples, 90.0))
+            << ", \"p99\": " << jsonNumber(percentile(r.samples, 99.0))
+            << ", \"max\": " << jsonNumber(percentile(r.samples, 100.0))
+            << "}, \"peak_rss_bytes\": " << r.peakRssBytes << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+inline void BenchmarkReport::writeSummary(std::ostream& out, const BenchmarkResult& result)
+{
+    double median = percentile(result.samples, 50.0);
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-18s %-6s N=%-10zu P=%-8zu p50=%.3es p99=%.3es %.3e %s/s rss=%.1fMiB",
+                  result.name.c_str(), result.type.c_str(), result.points, result.models, median,
+                  percentile(result.samples, 99.0), median > 0.0 ? result.work / median : 0.0,
+                  result.unit.c_str(), static_cast<double>(result.peakRssBytes) / (1024.0 * 1024.0));
+    out << line << '\n';
+}
+
+#endif // BENCHMARKREPORT_HXX
@@ -0,0 +1,71 @@
+/*
+ * SyntheticWorkload.h
+ * ----------------------
+ * Definición del generador de cargas sintéticas para las pruebas de rendimiento.
+ * Produce N puntos alrededor de una recta conocida y P modelos cercanos a ella,
+ * con ruido, grado de orden y tipo de dato configurables.
+ */
+
+#ifndef SYNTHETICWORKLOAD_H
+#define SYNTHETICWORKLOAD_H
+
+#include "DataPoint.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Estructura WorkloadConfig
+ * ----------------------------
+ * Parámetros de una carga sintética.
+ *  - points: número de puntos N.
+ *  - models: número de modelos P.
+ *  - noise: desviación estándar del ruido gaussiano añadido a y.
+ *  - sortedness: fracción de puntos que quedan en orden ascendente de x
+ *    (1 = completamente ordenados, 0 = orden aleatorio).
+ *  - seed: semilla del generador; la misma semilla produce la misma carga.
+ */
+struct WorkloadConfig {
+    std::size_t points = 1000;
+    std::size_t models = 10;
+    double noise = 1.0;
+    double sortedness = 0.0;
+    std::uint64_t seed = 42;
+};
+
+/*
+ * Plantilla de clase SyntheticWorkload
+ * ----------------------------
+ * Los puntos siguen y = trueSlope * x + trueIntercept + ruido, con x en [0, N)
+ * (comprimido para tipos enteros angostos).
+ * Los modelos perturban la pendiente y la ordenada de la recta verdadera, de
+ * modo que la selección del mejor modelo no sea trivial.
+ * T es el tipo de dato de los puntos (por ejemplo: int, float, double).
+ */
+template <typename T>
+class SyntheticWorkload {
+public:
+    std::vector<DataPoint<T>> points;
+    std::vector<std::pair<double, double>> models; // (pendiente, ordenada)
+
+    explicit SyntheticWorkload(const WorkloadConfig& config);
+
+    // Escribe la carga en el formato de texto .in (N, puntos, P, modelos)
+    void writeText(const std::string& fileName) const;
+
+private:
+    WorkloadConfig config;
+
+    void generatePoints();
+    void generateModels();
+};
+
+// Nombre del tipo de dato usado en los reportes ("int", "float", "double")
+template <typename T>
+const char* typeName();
+
+#include "SyntheticWorkload.hxx"
+
+#endif // SYNTHETICWORKLOAD_H
@@ -0,0 +1,128 @@
+/*
+ * SyntheticWorkload.hxx
+ * ----------------------
+ * Implementación del generador de cargas sintéticas.
+ */
+
+#ifndef SYNTHETICWORKLOAD_HXX
+#define SYNTHETICWORKLOAD_HXX
+
+#include "SyntheticWorkload.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+
+// Recta alrededor de la que se generan los puntos y los modelos
+const double WORKLOAD_TRUE_SLOPE = 1.5;
+const double WORKLOAD_TRUE_INTERCEPT = 10.0;
+
+// Convierte un valor generado al tipo de los puntos, redondeando para enteros
+template <typename T>
+T workloadValue(double value)
+{
+    return std::is_integral<T>::value ? static_cast<T>(std::llround(value)) : static_cast<T>(value);
+}
+
+template <typename T>
+SyntheticWorkload<T>::SyntheticWorkload(const WorkloadConfig& config) : config(config)
+{
+    generatePoints();
+    generateModels();
+}
+
+/*
+ * Implementación del método generatePoints
+ * -----------------------------------------
+ * Genera los puntos ordenados por x y luego intercambia cada posición con otra
+ * al azar con probabilidad 1 - sortedness.
+ */
+template <typename T>
+void SyntheticWorkload<T>::generatePoints()
+{
+    std::mt19937_64 random(config.seed);
+    std::normal_distribution<double> noise(0.0, config.noise > 0.0 ? config.noise : 1.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Para enteros angostos (int16) x se comprime para que y quepa en T
+    double xScale = 1.0;
+    if (std::is_integral<T>::value && config.points > 0) {
+        double xLimit = static_cast<double>(std::numeric_limits<T>::max()) / (2.0 * WORKLOAD_TRUE_SLOPE);
+        xScale = std::min(1.0, xLimit / static_cast<double>(config.points));
+    }
+
+    points.clear();
+    points.reserve(config.points);
+    for (std::size_t i = 0; i < config.points; ++i) {
+        double x = std::is_integral<T>::value ? std::floor(static_cast<double>(i) * xScale)
+                                              : static_cast<double>(i) + unit(random);
+        double y = WORKLOAD_TRUE_SLOPE * x + WORKLOAD_TRUE_INTERCEPT;
+        if (config.noise > 0.0)
+            y += noise(random);
+        points.push_back(DataPoint<T>(workloadValue<T>(x), workloadValue<T>(y)));
+    }
+
+    if (config.points < 2 || config.sortedness >= 1.0)
+        return;
+    std::uniform_int_distribution<std::size_t> position(0, config.points - 1);
+    for (std::size_t i = 0; i < config.points; ++i) {
+        if (unit(random) >= config.sortedness)
+            std::swap(points[i], points[position(random)]);
+    }
+}
+
+template <typename T>
+void SyntheticWorkload<T>::generateModels()
+{
+    std::mt19937_64 random(config.seed ^ 0x9E3779B97F4A7C15ull);
+    std::normal_distribution<double> slopeOffset(0.0, 0.05);
+    std::normal_distribution<double> interceptOffset(0.0, 5.0);
+
+    models.clear();
+    models.reserve(config.models);
+    for (std::size_t m = 0; m < config.models; ++m)
+        models.push_back(std::make_pair(WORKLOAD_TRUE_SLOPE + slopeOffset(random),
+                                        WORKLOAD_TRUE_INTERCEPT + interceptOffset(random)));
+}
+
+/*
+ * Implementación del método writeText
+ * ------------------------------------
+ * Usa printf con 17 dígitos significativos para que la lectura reproduzca los
+ * mismos valores.
+ */
+template <typename T>
+void SyntheticWorkload<T>::writeText(const std::string& fileName) const
+{
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file)
+        throw std::runtime_error("Error al crear el archivo: " + fileName);
+
+    std::fprintf(file, "%zu\n", points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+        std::fprintf(file, "%.17g %.17g\n", static_cast<double>(points[i].x), static_cast<double>(points[i].y));
+    std::fprintf(file, "%zu\n", models.size());
+    for (std::size_t m = 0; m < models.size(); ++m)
+        std::fprintf(file, "%.17g %.17g\n", models[m].first, models[m].second);
+
+    bool failed = std::ferror(file) != 0;
+    if (std::fclose(file) != 0 || failed)
+        throw std::runtime_error("Error al escribir el archivo: " + fileName);
+}
+
+template <>
+inline const char* typeName<std::int16_t>() { return "int16"; }
+
+template <>
+inline const char* typeName<int>() { return "int"; }
+
+template <>
+inline const char* typeName<float>() { return "float"; }
+
+template <>
+inline const char* typeName<double>() { return "double"; }
+
+#endif // SYNTHETICWORKLOAD_HXX
@@ -0,0 +1,380 @@
+/*
+ * bench.cxx
+ * ----------------------
+ * Pruebas de rendimiento de la inserción, la evaluación, la selección de
+ * modelos y la lectura de archivos sobre cargas sintéticas.
+ * Recorre combinaciones de N puntos y P modelos y escribe un reporte JSON con
+ * rendimiento, percentiles de latencia y memoria residente máxima.
+ */
+
+#include "EvaluationSystem.h"
+#include "DataFileReader.h"
+#include "BinaryDataFile.h"
+#include "SyntheticWorkload.h"
+#include "BenchmarkReport.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Estructura BenchOptions
+ * ----------------------------
+ * Parámetros de la corrida leídos de la línea de comandos.
+ *  - pointCounts, modelCounts: valores de N y P a recorrer.
+ *  - maxWork: límite de puntos·modelos por caso de evaluación; las
+ *    combinaciones mayores se omiten para que un barrido hasta N = 10^8 y
+ *    P = 10^6 no intente las esquinas impracticables.
+ *  - insertLimit: N máximo para la inserción punto a punto, que es O(N) por punto.
+ */
+struct BenchOptions {
+    std::vector<std::size_t> pointCounts = {1000, 10000, 100000, 1000000};
+    std::vector<std::size_t> modelCounts = {1, 100, 10000};
+    std::string type = "double";
+    std::set<std::string> benchmarks = {"insert", "calculate", "evaluate", "select", "fit", "parse"};
+    std::size_t repeat = 5;
+    std::size_t threads = 1;
+    double maxWork = 2e9;
+    std::size_t insertLimit = 100000;
+    std::string workDir = ".";
+    std::string output;
+    WorkloadConfig workload;
+};
+
+// Mide body() repeat veces; cada repetición es una muestra de latencia
+template <typename Body>
+std::vector<double> timeRepetitions(std::size_t repeat, Body body)
+{
+    std::vector<double> samples;
+    samples.reserve(repeat);
+    for (std::size_t r = 0; r < repeat; ++r) {
+        double start = monotonicSeconds();
+        body();
+        samples.push_back(monotonicSeconds() - start);
+    }
+    return samples;
+}
+
+/*
+ * Clase BenchRunner
+ * ----------------------------
+ * Ejecuta los casos de un tipo de dato T y los añade al reporte.
+ */
+template <typename T>
+class BenchRunner {
+public:
+    BenchRunner(const BenchOptions& options, BenchmarkReport& report) : options(options), report(report) {}
+
+    void run()
+    {
+        std::size_t maxModels = 0;
+        for (std::size_t P : options.modelCounts)
+            maxModels = std::max(maxModels, P);
+
+        for (std::size_t N : options.pointCounts) {
+            WorkloadConfig config = options.workload;
+            config.points = N;
+            config.models = maxModels;
+            SyntheticWorkload<T> workload(config);
+
+            if (enabled("insert"))
+                benchInsert(workload);
+            if (enabled("fit"))
+                benchFit(workload);
+            for (std::size_t P : options.modelCounts) {
+                if (static_cast<double>(N) * static_cast<double>(P) > options.maxWork) {
+                    std::cerr << "Omitido N=" << N << " P=" << P << ": supera --max-work" << std::endl;
+                    continue;
+                }
+                if (enabled("calculate") || enabled("evaluate") || enabled("select"))
+                    benchEvaluation(workload, P);
+                if (enabled("parse"))
+                    benchParse(workload, P);
+            }
+        }
+    }
+
+private:
+    const BenchOptions& options;
+    BenchmarkReport& report;
+
+    bool enabled(const std::string& name) const
+    {
+        return options.benchmarks.count(name) != 0;
+    }
+
+    void record(const std::string& name, std::size_t N, std::size_t P, double work, const std::string& unit,
+                const std::vector<double>& samples)
+    {
+        BenchmarkResult result;
+        result.name = name;
+        result.type = typeName<T>();
+        result.points = N;
+        result.models = P;
+        result.work = work;
+        result.unit = unit;
+        result.samples = samples;
+        result.peakRssBytes = peakResidentBytes();
+        BenchmarkReport::writeSummary(std::cerr, result);
+        report.add(result);
+    }
+
+    // Sistema con los N puntos de la carga (cargados por lotes) y sus primeros P modelos
+    std::unique_ptr<EvaluationSystem<T>> buildSystem(const SyntheticWorkload<T>& workload, std::size_t P) const
+    {
+        std::unique_ptr<EvaluationSystem<T>> system(new EvaluationSystem<T>());
+        system->setThreadCount(options.threads);
+        system->addDataPoints(workload.points.begin(), workload.points.end());
+        for (std::size_t m = 0; m < P; ++m)
+            system->addModel(workload.models[m].first, workload.models[m].second);
+        return system;
+    }
+
+    /*
+     * Inserción punto a punto (addDataPoint) con una muestra por llamada, y
+     * carga por lotes (addDataPoints) con una muestra por repetición.
+     */
+    void benchInsert(const SyntheticWorkload<T>& workload)
+    {
+        const std::size_t N = workload.points.size();
+        if (N <= options.insertLimit) {
+            DataSet<T> dataSet;
+            std::vector<double> samples;
+            samples.reserve(N);
+            for (const DataPoint<T>& point : workload.points) {
+                double start = monotonicSeconds();
+                dataSet.addDataPoint(point.x, point.y);
+                samples.push_back(monotonicSeconds() - start);
+            }
+            record("addDataPoint", N, 0, 1.0, "points", samples);
+        } else {
+            std::cerr << "Omitido addDataPoint N=" << N << ": supera --insert-limit" << std::endl;
+        }
+
+        std::vector<double> samples = timeRepetitions(options.repeat, [&]() {
+            DataSet<T> dataSet;
+            dataSet.addDataPoints(workload.points.begin(), workload.points.end());
+        });
+        record("addDataPoints", N, 0, static_cast<double>(N), "points", samples);
+    }
+
+    void benchEvaluation(const SyntheticWorkload<T>& workload, std::size_t P)
+    {
+        if (P == 0)
+            return;
+        const std::size_t N = workload.points.size();
+        const double work = static_cast<double>(N) * static_cast<double>(P);
+        std::unique_ptr<EvaluationSystem<T>> system = buildSystem(workload, P);
+        DataSet<T>& dataSet = system->dataSet;
+        LinearRegression<T> first = dataSet.modelBank.toModel(0);
+
+        if (enabled("calculate")) {
+            record("calculateMAE", N, P, work, "point-models",
+                   timeRepetitions(options.repeat, [&]() { first.calculateMAE(dataSet); }));
+            record("calculateMSE", N, P, work, "point-models",
+                   timeRepetitions(options.repeat, [&]() { first.calculateMSE(dataSet); }));
+            record("calculateRMSE", N, P, work, "point-models",
+                   timeRepetitions(options.repeat, [&]() { first.calculateRMSE(dataSet); }));
+            record("calculateMetrics", N, P, work, "point-models",
+                   timeRepetitions(options.repeat, [&]() { first.calculateMetrics(dataSet); }));
+        }
+        if (enabled("evaluate") || enabled("select")) {
+            // runEvaluation usa evaluateModels o el evaluador en paralelo según --threads
+            std::vector<double> samples = timeRepetitions(options.repeat, [&]() { system->runEvaluation(); });
+            if (enabled("evaluate"))
+                record("evaluateModels", N, P, work, "point-models", samples);
+        }
+        if (enabled("select")) {
+            const char* metrics[] = {"MAE", "MSE", "RMSE"};
+            for (const char* metric : metrics)
+                record(std::string("findBestModel_") + metric, N, P, static_cast<double>(P), "models",
+                       timeRepetitions(options.repeat, [&]() { dataSet.findBestModel(metric); }));
+            record("findBestModels", N, P, static_cast<double>(P), "models",
+                   timeRepetitions(options.repeat, [&]() { dataSet.findBestModels(); }));
+        }
+    }
+
+    // Ajuste directo de las rectas óptimas; no depende de P
+    void benchFit(const SyntheticWorkload<T>& workload)
+    {
+        const std::size_t N = workload.points.size();
+        std::unique_ptr<EvaluationSystem<T>> system = buildSystem(workload, 0);
+        record("fitLeastSquares", N, 0, static_cast<double>(N), "points",
+               timeRepetitions(options.repeat, [&]() { system->fitModel("MSE"); }));
+        record("fitLeastAbsoluteDeviations", N, 0, static_cast<double>(N), "points",
+               timeRepetitions(options.repeat, [&]() { system->fitModel("MAE"); }));
+    }
+
+    // Lectura del formato .in y del formato binario de la misma carga
+    void benchParse(const SyntheticWorkload<T>& workload, std::size_t P)
+    {
+        const std::size_t N = workload.points.size();
+        const std::string textFile = options.workDir + "/bench_workload.in";
+        const std::string binaryFile = options.workDir + "/bench_workload.bin";
+
+        SyntheticWorkload<T> subset = workload;
+        subset.models.resize(P);
+        subset.writeText(textFile);
+        double textBytes = static_cast<double>(MappedFile(textFile).size());
+        record("parseText", N, P, textBytes, "bytes", timeRepetitions(options.repeat, [&]() {
+            EvaluationSystem<T> system;
+            DataFileReader(textFile).load(system);
+        }));
+
+        {
+            std::unique_ptr<EvaluationSystem<T>> system = buildSystem(workload, P);
+            writeBinaryDataFile(binaryFile, system->dataSet);
+        }
+        double binaryBytes = static_cast<double>(MappedFile(binaryFile).size());
+        record("loadBinary", N, P, binaryBytes, "bytes", timeRepetitions(options.repeat, [&]() {
+            EvaluationSystem<T> system;
+            loadBinaryDataFile(binaryFile, system);
+        }));
+
+        std::remove(textFile.c_str());
+        std::remove(binaryFile.c_str());
+    }
+};
+
+// Lee una lista separada por comas; admite notación científica (1e8)
+std::vector<std::size_t> parseCountList(const std::string& text)
+{
+    std::vector<std::size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        char* end = nullptr;
+        double value = std::strtod(item.c_str(), &end);
+        if (item.empty() || *end != '\0' || value < 0.0)
+            throw std::invalid_argument("Lista de cantidades inválida: " + text);
+        values.push_back(static_cast<std::size_t>(value));
+    }
+    return values;
+}
+
+std::set<std::string> parseNameList(const std::string& text)
+{
+    std::set<std::string> names;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        names.insert(item);
+    return names;
+}
+
+void printUsage(const char *program)
+{
+    std::cerr << "Uso: " << program << " [opciones]\n"
+              << "  --points LISTA      Valores de N, por ejemplo 1e3,1e6,1e8\n"
+              << "  --models LISTA      Valores de P, por ejemplo 1,1e3,1e6\n"
+              << "  --type T            int16, int, float o double\n"
+              << "  --noise S           Desviación estándar del ruido\n"
+              << "  --sortedness F      Fracción de puntos ya ordenados (0 a 1)\n"
+              << "  --seed S            Semilla del generador\n"
+              << "  --bench LISTA       insert,calculate,evaluate,select,fit,parse\n"
+              << "  --repeat R          Repeticiones por caso\n"
+              << "  --threads N         Hilos de runEvaluation (0 = todos los núcleos)\n"
+              << "  --max-work W        Máximo de puntos·modelos por caso de evaluación\n"
+              << "  --insert-limit N    N máximo para addDataPoint punto a punto\n"
+              << "  --work-dir DIR      Directorio de los archivos temporales de lectura\n"
+              << "  --output ARCHIVO    Escribe el JSON en un archivo en lugar de la salida estándar"
+              << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    BenchOptions options;
+    try
+    {
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            const std::string &arg = args[i];
+            if (i + 1 >= args.size())
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const std::string &value = args[++i];
+            if (arg == "--points")
+                options.pointCounts = parseCountList(value);
+            else if (arg == "--models")
+                options.modelCounts = parseCountList(value);
+            else if (arg == "--type")
+                options.type = value;
+            else if (arg == "--noise")
+                options.workload.noise = std::strtod(value.c_str(), nullptr);
+            else if (arg == "--sortedness")
+                options.workload.sortedness = std::strtod(value.c_str(), nullptr);
+            else if (arg == "--seed")
+                options.workload.seed = std::strtoull(value.c_str(), nullptr, 10);
+            else if (arg == "--bench")
+                options.benchmarks = parseNameList(value);
+            else if (arg == "--repeat")
+                options.repeat = std::max<std::size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--threads")
+                options.threads = std::strtoul(value.c_str(), nullptr, 10);
+            else if (arg == "--max-work")
+                options.maxWork = std::strtod(value.c_str(), nullptr);
+            else if (arg == "--insert-limit")
+                options.insertLimit = parseCountList(value).at(0);
+            else if (arg == "--work-dir")
+                options.workDir = value;
+            else if (arg == "--output")
+                options.output = value;
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        BenchmarkReport report;
+        report.setConfig("type", options.type);
+        report.setConfig("noise", options.workload.noise);
+        report.setConfig("sortedness", options.workload.sortedness);
+        report.setConfig("seed", static_cast<double>(options.workload.seed));
+        report.setConfig("repeat", static_cast<double>(options.repeat));
+        report.setConfig("threads", static_cast<double>(options.threads));
+
+        if (options.type == "double")
+            BenchRunner<double>(options, report).run();
+        else if (options.type == "float")
+            BenchRunner<float>(options, report).run();
+        else if (options.type == "int")
+            BenchRunner<int>(options, report).run();
+        else if (options.type == "int16")
+            BenchRunner<std::int16_t>(options, report).run();
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        if (options.output.empty())
+        {
+            report.writeJson(std::cout);
+        }
+        else
+        {
+            std::ofstream out(options.output);
+            if (!out)
+                throw std::runtime_error("Error al crear el archivo: " + options.output);
+            report.writeJson(out);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
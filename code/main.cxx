@@ -6,21 +6,35 @@
  */
 
 #include "EvaluationSystem.h"
+#include "DataFileReader.h"
+#include "BinaryDataFile.h"
+#include "BatchPipeline.h"
+#include "Stats.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
-void readDataPoints(std::ifstream &inputFile, EvaluationSystem<double> &system, int N)
+template <typename T>
+void readDataPoints(std::istream &inputFile, EvaluationSystem<T> &system, int N)
 {
+    // Carga por lotes: se ordena una sola vez al confirmar
+    system.beginBatch(N);
     for (int i = 0; i < N; i++)
     {
         double x, y;
         inputFile >> x >> y;
-        system.addDataPoint(x, y);
+        system.addDataPoint(static_cast<T>(x), static_cast<T>(y));
     }
+    system.commitBatch();
 }
 
-void ReadModels (std::ifstream &inputFile, EvaluationSystem<double> &system, int P) {
+template <typename T>
+void ReadModels (std::istream &inputFile, EvaluationSystem<T> &system, int P) {
     for (int i = 0; i < P; i++)
     {
         double M, B;
@@ -29,59 +43,322 @@ void ReadModels (std::ifstream &inputFile, EvaluationSystem<double> &system, int
     }
 }
 
-int main(int argc, char *argv[])
+/*
+ * Lectura desde un flujo (por ejemplo, la entrada estándar redirigida).
+ * Se conserva para cuando la entrada no es un archivo que se pueda proyectar.
+ */
+template <typename T>
+void readFromStream(std::istream &inputFile, EvaluationSystem<T> &system)
 {
-    if (argc < 2)
+    int N;
+    inputFile >> N;
+
+    if (N <= 0)
     {
-        std::cerr << "Uso: " << argv[0] << " <nombre_del_archivo>" << std::endl;
-        return 1;
+        throw std::runtime_error("El número de puntos debe ser mayor que cero.");
     }
 
-    std::string fileName = argv[1];
-    std::ifstream inputFile(fileName);
+    readDataPoints(inputFile, system, N);
+
+    int P;
+    inputFile >> P;
 
-    if (!inputFile.is_open())
+    if (P <= 0)
     {
-        std::cerr << "Error al abrir el archivo: " << fileName << std::endl;
-        return 1;
+        throw std::runtime_error("El número de modelos debe ser mayor que cero.");
     }
 
-    EvaluationSystem<double> system;
+    ReadModels(inputFile, system, P);
+}
 
-    try
+/*
+ * Carga la entrada según su origen: la entrada estándar ("-") o una ruta que
+ * no se puede proyectar (FIFO, <(...)) se leen como flujo de texto; un archivo
+ * binario por columnas se proyecta sin copiar y un archivo .in se analiza
+ * con DataFileReader.
+ */
+template <typename T>
+void loadInput(const std::string &fileName, EvaluationSystem<T> &system, bool verifyChecksum)
+{
+    STATS_TIMER(Parse);
+    if (fileName == "-")
+    {
+        readFromStream(std::cin, system);
+    }
+    else if (!isMappableFile(fileName))
+    {
+        // Se comprueba antes de isBinaryDataFile, que consumiría la firma del flujo
+        std::ifstream input(fileName);
+        if (!input.is_open())
+            throw std::runtime_error("Error al abrir el archivo: " + fileName);
+        readFromStream(input, system);
+    }
+    else if (isBinaryDataFile(fileName))
+    {
+        loadBinaryDataFile(fileName, system, verifyChecksum);
+    }
+    else
+    {
+        DataFileReader reader(fileName);
+        reader.load(system);
+    }
+}
+
+/*
+ * Tipo de punto cuando no se indica --type: el guardado en la cabecera si la
+ * entrada es un archivo binario, y double en otro caso.
+ */
+std::string defaultPointType(const std::string &fileName)
+{
+    if (fileName == "-" || !isMappableFile(fileName))
+        return "double";
+    switch (binaryDataFileTypeCode(fileName))
     {
+    case BinaryTypeCode<std::int16_t>::value:
+        return "int16";
+    case BinaryTypeCode<std::int32_t>::value:
+        return "int32";
+    case BinaryTypeCode<float>::value:
+        return "float";
+    default:
+        return "double";
+    }
+}
 
-        int N;
-        inputFile >> N;
+void printUsage(const char *program)
+{
+    std::cerr << "Uso: " << program << " [opciones] [--halving TOL | --fit] <nombre_del_archivo | ->\n"
+              << "     " << program << " --batch [opciones] <archivo | directorio>...\n"
+              << "     " << program << " --convert [--type T] <entrada.in> <salida.bin>\n"
+              << "Opciones: --threads N, --no-verify, --stats [json|text],\n"
+              << "          --type double|float|int32|int16 (tipo de los puntos; por omisión el de\n"
+              << "          la cabecera de un archivo binario, o double)" << std::endl;
+}
 
-        if (N <= 0)
-        {
-            throw std::runtime_error("El número de puntos debe ser mayor que cero.");
-        }
+/*
+ * Escribe las estadísticas en la salida de errores para no mezclarlas con los
+ * resultados. Sin CODE_STATS solo avisa que la instrumentación no está compilada.
+ */
+void printStats(const std::string &format)
+{
+    if (format.empty())
+        return;
+#ifdef CODE_STATS
+    if (format == "json")
+        Stats::instance().writeJson(std::cerr);
+    else
+        Stats::instance().writeText(std::cerr);
+#else
+    std::cerr << "Estadisticas no disponibles: compilar con CODE_STATS activado" << std::endl;
+#endif
+}
+
+/*
+ * Convierte el número de hilos de --threads. Retorna false si el texto no es
+ * un entero no negativo completo o está fuera de rango.
+ */
+bool parseThreadCount(const std::string &text, std::size_t &threads)
+{
+    char *end = nullptr;
+    errno = 0;
+    long value = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || errno == ERANGE || value < 0)
+        return false;
+    threads = static_cast<std::size_t>(value);
+    return true;
+}
 
-        readDataPoints(inputFile, system, N);
+/*
+ * Convierte la tolerancia de --halving. Retorna false si el texto no es un
+ * número completo, finito y no negativo.
+ */
+bool parseTolerance(const std::string &text, double &tolerance)
+{
+    char *end = nullptr;
+    errno = 0;
+    double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || errno == ERANGE || !std::isfinite(value) || value < 0.0)
+        return false;
+    tolerance = value;
+    return true;
+}
 
-        int P;
-        inputFile >> P;
+/*
+ * Opciones de la línea de comandos comunes a todos los tipos de punto.
+ */
+struct RunOptions
+{
+    bool convert = false;
+    bool verifyChecksum = true;
+    std::size_t threads = 1;
+    std::string statsFormat; // Vacío si no se pidió --stats
+    bool halving = false;
+    HalvingOptions halvingOptions;
+    bool fit = false;
+    std::vector<std::string> files;
+};
 
-        if (P <= 0)
+/*
+ * Modo por lotes: procesa cada archivo (o los archivos .in y .bin de cada
+ * directorio) en el pipeline de lectura, evaluación y formato. Retorna 1 si
+ * algún archivo falló.
+ */
+template <typename T>
+int runBatch(const RunOptions &options)
+{
+    std::size_t failures = 0;
+    try
+    {
+        std::vector<std::string> files = collectInputFiles(options.files);
+        bool verifyChecksum = options.verifyChecksum;
+        BatchPipeline<T> pipeline([verifyChecksum](const std::string &fileName, EvaluationSystem<T> &system) {
+            loadInput(fileName, system, verifyChecksum);
+        }, options.threads);
+        failures = pipeline.run(files, std::cout);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printStats(options.statsFormat);
+        return 1;
+    }
+
+    printStats(options.statsFormat);
+    return failures == 0 ? 0 : 1;
+}
+
+/*
+ * Modo de un solo archivo: conversión a binario, selección por eliminación
+ * sucesiva, ajuste directo de las rectas óptimas o evaluación completa con
+ * impresión de resultados.
+ */
+template <typename T>
+int runSingle(const RunOptions &options)
+{
+    EvaluationSystem<T> system;
+    system.setThreadCount(options.threads);
+
+    try
+    {
+        loadInput(options.files[0], system, options.verifyChecksum);
+
+        if (options.convert)
         {
-            throw std::runtime_error("El número de modelos debe ser mayor que cero.");
+            writeBinaryDataFile(options.files[1], system.dataSet);
+            return 0;
         }
 
-        ReadModels(inputFile, system, P);
+        if (options.halving)
+        {
+            // Solo la selección: no se evalúan todos los modelos en todos los puntos.
+            // La selección cuenta en Select y la impresión en Output (ver printBestModelsHalving)
+            system.printBestModelsHalving(options.halvingOptions);
+            printStats(options.statsFormat);
+            return 0;
+        }
 
-        inputFile.close();
+        if (options.fit)
+        {
+            // Solo el ajuste: los modelos del archivo no se evalúan.
+            // El ajuste cuenta en Select y la impresión en Output (ver printFittedModels)
+            system.printFittedModels();
+            printStats(options.statsFormat);
+            return 0;
+        }
 
         system.runEvaluation();
-        system.printResults();
-        system.printBestModels();
+        {
+            STATS_TIMER(Output);
+            system.printResults();
+            system.printBestModels();
+        }
     }
     catch (const std::exception &e)
     {
         std::cerr << "Error: " << e.what() << std::endl;
+        printStats(options.statsFormat);
         return 1;
     }
 
+    printStats(options.statsFormat);
     return 0;
 }
+
+template <typename T>
+int run(const RunOptions &options, bool batch)
+{
+    return batch ? runBatch<T>(options) : runSingle<T>(options);
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    RunOptions options;
+    bool batch = false;
+    std::string type; // Vacío si no se indicó --type
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        const std::string &arg = args[i];
+        if (arg == "--convert")
+            options.convert = true;
+        else if (arg == "--batch")
+            batch = true;
+        else if (arg == "--no-verify")
+            options.verifyChecksum = false;
+        else if (arg == "--threads" && i + 1 < args.size())
+        {
+            if (!parseThreadCount(args[++i], options.threads))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--type" && i + 1 < args.size())
+            type = args[++i];
+        else if (arg == "--halving" && i + 1 < args.size())
+        {
+            options.halving = true;
+            if (!parseTolerance(args[++i], options.halvingOptions.tolerance))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--fit")
+            options.fit = true;
+        else if (arg == "--stats")
+        {
+            options.statsFormat = "text";
+            if (i + 1 < args.size() && (args[i + 1] == "json" || args[i + 1] == "text"))
+                options.statsFormat = args[++i];
+        }
+        else
+            options.files.push_back(arg);
+    }
+
+    bool validBatch = batch && !options.convert && !options.halving && !options.fit && !options.files.empty();
+    // --fit, --halving y --convert son modos excluyentes
+    bool exclusiveModes = (options.fit ? 1 : 0) + (options.halving ? 1 : 0) + (options.convert ? 1 : 0) <= 1;
+    bool validSingle = !batch && exclusiveModes &&
+                       options.files.size() == (options.convert ? 2u : 1u);
+    if (!(validBatch || validSingle))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Los datos enteros se guardan en su tipo nativo: int16 ocupa la cuarta parte que double
+    if (type.empty())
+        type = batch || options.convert ? "double" : defaultPointType(options.files[0]);
+    if (type == "double")
+        return run<double>(options, batch);
+    if (type == "float")
+        return run<float>(options, batch);
+    if (type == "int32")
+        return run<std::int32_t>(options, batch);
+    if (type == "int16")
+        return run<std::int16_t>(options, batch);
+
+    printUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,100 @@
+/*
+ * BinaryDataFileTest.cxx
+ * ----------------------
+ * Comprueba que la carga binaria rechaza cabeceras corruptas, incluso con
+ * recuentos que desbordarían la aritmética de desplazamientos, con y sin
+ * verificación de la suma; que con verificación rechaza una columna x
+ * desordenada, y que la cabecera informa el tipo de elemento.
+ */
+
+#include "BinaryDataFile.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Suma delta al campo de la cabecera ubicado en offset
+void patchHeader(const std::string& fileName, std::size_t offset, std::uint64_t delta)
+{
+    std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+    std::uint64_t value = 0;
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    value += delta;
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Intercambia los dos primeros valores de x y vuelve a calcular la suma de verificación
+void swapFirstXValues(const std::string& fileName)
+{
+    BinaryFileHeader header;
+    std::vector<char> bytes;
+    {
+        MappedFile file(fileName);
+        bytes.assign(file.data(), file.data() + file.size());
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    char* xs = bytes.data() + header.xOffset;
+    std::swap_ranges(xs, xs + sizeof(double), xs + sizeof(double));
+    header.checksum = binaryFileChecksum(bytes.data(), bytes.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Indica si cargar el archivo lanza std::runtime_error
+bool loadFails(const std::string& fileName, bool verifyChecksum)
+{
+    try {
+        EvaluationSystem<double> system;
+        loadBinaryDataFile(fileName, system, verifyChecksum);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    const std::string fileName = "BinaryDataFileTest.bin";
+    DataSet<double> dataSet;
+    for (int i = 0; i < 100; ++i)
+        dataSet.addDataPoint(i, 2.0 * i + 1.0);
+    dataSet.addModel(2.0, 1.0);
+
+    writeBinaryDataFile(fileName, dataSet);
+    CHECK(!loadFails(fileName, true));
+
+    // Un recuento de 2^61 + N hace que N·sizeof(T) dé la vuelta en 64 bits
+    patchHeader(fileName, offsetof(BinaryFileHeader, pointCount), std::uint64_t(1) << 61);
+    CHECK(loadFails(fileName, true));
+    CHECK(loadFails(fileName, false));
+
+    // La suma de verificación también cubre la cabecera
+    writeBinaryDataFile(fileName, dataSet);
+    patchHeader(fileName, offsetof(BinaryFileHeader, reserved), 1);
+    CHECK(loadFails(fileName, true));
+    CHECK(!loadFails(fileName, false));
+
+    // Una columna x desordenada con suma válida solo pasa sin verificación
+    writeBinaryDataFile(fileName, dataSet);
+    swapFirstXValues(fileName);
+    CHECK(loadFails(fileName, true));
+    CHECK(!loadFails(fileName, false));
+
+    CHECK(binaryDataFileTypeCode(fileName) == BinaryTypeCode<double>::value);
+    DataSet<std::int16_t> smallDataSet;
+    smallDataSet.addDataPoint(1, 2);
+    smallDataSet.addModel(2.0, 0.0);
+    writeBinaryDataFile(fileName, smallDataSet);
+    CHECK(binaryDataFileTypeCode(fileName) == BinaryTypeCode<std::int16_t>::value);
+
+    std::remove(fileName.c_str());
+    return testResult();
+}
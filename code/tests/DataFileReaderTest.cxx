@@ -0,0 +1,32 @@
+/*
+ * DataFileReaderTest.cxx
+ * ----------------------
+ * Comprueba que un N mayor que el contenido del archivo se informa como un
+ * error de formato con su posición, sin reservar memoria para N puntos.
+ */
+
+#include "DataFileReader.h"
+#include "TestCheck.h"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+int main()
+{
+    const std::string fileName = "DataFileReaderTest.in";
+    {
+        std::ofstream file(fileName);
+        file << "1000000000000\n1 2\n1\n1 1\n";
+    }
+
+    std::string message;
+    try {
+        EvaluationSystem<double> system;
+        DataFileReader reader(fileName);
+        reader.load(system);
+    } catch (const std::runtime_error& e) {
+        message = e.what();
+    }
+    CHECK(message.find(fileName + ":5:1: se esperaban 1000000000000 puntos") == 0);
+    return testResult();
+}
@@ -0,0 +1,39 @@
+/*
+ * IntegerPredictionTest.cxx
+ * ----------------------
+ * Comprueba que con datos enteros las métricas usan la misma predicción que
+ * predict(): redondeada y saturada al rango de T, tanto en la ruta rápida
+ * como en la evaluación exacta.
+ */
+
+#include "DataSet.h"
+#include "LinearRegression.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <cstdint>
+
+// Indica si MAE, MSE y residualOf en el punto (x, y) coinciden con |y - predict(x)|
+template <typename T>
+bool metricsMatchPrediction(T x, T y, double slope, double intercept)
+{
+    DataSet<T> dataSet;
+    dataSet.addDataPoint(x, y);
+    dataSet.addModel(slope, intercept);
+    dataSet.evaluateModels();
+    LinearRegression<T> model = dataSet.models().front();
+    DataPoint<T> predicted = model.predict(DataPoint<T>(x, 0));
+    double expected = std::fabs(static_cast<double>(y) - static_cast<double>(predicted.y));
+    return model.getMAE() == expected && model.getMSE() == expected * expected &&
+           std::fabs(residualOf(x, y, slope, intercept)) == expected;
+}
+
+int main()
+{
+    // int16: y' = 100000 se satura a 32767; la ruta rápida acepta el residuo
+    CHECK(metricsMatchPrediction<std::int16_t>(1000, 30000, 100.0, 0.0));
+    CHECK(metricsMatchPrediction<std::int16_t>(-1000, -30000, 100.0, 0.0));
+    // int32: el residuo saturado excede 2^20 y se usa la evaluación exacta
+    CHECK(metricsMatchPrediction<std::int32_t>(1000, 0, 1e7, 0.0));
+    CHECK(metricsMatchPrediction<std::int32_t>(-1000, 5, 1e30, 0.0));
+    return testResult();
+}
@@ -0,0 +1,53 @@
+/*
+ * ModelBankTest.cxx
+ * ----------------------
+ * Comprueba que el banco es el único dueño de los modelos: las ediciones con
+ * setModel se reflejan en la evaluación, la selección y el modo de flujo, y
+ * un modelo con métricas NaN no obliga a recalcular las sumas de los demás.
+ */
+
+#include "DataSet.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <limits>
+
+int main()
+{
+    DataSet<double> dataSet;
+    for (int i = 0; i < 10; ++i)
+        dataSet.addDataPoint(i, 2.0 * i);
+    dataSet.addModel(1.0, 0.0);
+    dataSet.addModel(3.0, 0.0);
+
+    dataSet.evaluateModels();
+    CHECK(dataSet.findBestModels().mse == 0);
+    CHECK(dataSet.models().size() == 2);
+
+    // Editar un modelo descarta sus métricas hasta la siguiente evaluación
+    dataSet.setModel(0, 2.0, 0.0);
+    CHECK(!dataSet.models().front().isMSECalculated());
+    CHECK(dataSet.findBestModels().mse == NO_MODEL);
+    dataSet.evaluateModels();
+    CHECK(dataSet.models().front().getMSE() == 0.0);
+    CHECK(dataSet.findBestModel("MSE").getSlope() == 2.0);
+
+    // La lista es una copia: modificarla no cambia el conjunto
+    dataSet.models().front().setSlope(5.0);
+    CHECK(dataSet.modelBank.slopes[0] == 2.0);
+
+    // En modo de flujo, el modelo editado se reevalúa sin tocar a los demás
+    dataSet.enableStreaming();
+    dataSet.setModel(0, 2.0, 1.0);
+    CHECK(nearlyEqual(dataSet.models().front().getMSE(), 1.0, 1e-12));
+    dataSet.addDataPoint(10, 20);
+    CHECK(nearlyEqual(dataSet.models().front().getMSE(), 1.0, 1e-12));
+
+    // Pendiente infinita en x = 0: MSE NaN, y las sumas de los demás siguen al día
+    dataSet.addModel(std::numeric_limits<double>::infinity(), 0.0);
+    CHECK(std::isnan(dataSet.models().back().getMSE()));
+    dataSet.addDataPoint(11, 22);
+    CHECK(nearlyEqual(dataSet.models().front().getMSE(), 1.0, 1e-12));
+    // Residuo -x para y = 3x sobre x = 0..11: Σx² = 506
+    CHECK(nearlyEqual(dataSet.modelBank.mseValues[1], 506.0 / 12.0, 1e-12));
+    return testResult();
+}
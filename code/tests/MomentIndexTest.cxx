@@ -0,0 +1,55 @@
+/*
+ * MomentIndexTest.cxx
+ * ----------------------
+ * Compara el MSE por rango del índice de momentos con la evaluación directa,
+ * en particular sobre ventanas estrechas lejos del origen.
+ */
+
+#include "DataSet.h"
+#include "TestCheck.h"
+#include <cstddef>
+#include <vector>
+
+// MSE exacto de la recta sobre los puntos con x en [xLo, xHi], recorriéndolos uno a uno
+double directRangeMSE(const DataSet<double>& dataSet, double slope, double intercept, double xLo, double xHi)
+{
+    double sum = 0.0;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < dataSet.pointCount(); ++i) {
+        double x = dataSet.xData()[i];
+        if (x < xLo || x > xHi)
+            continue;
+        double residual = dataSet.yData()[i] - (slope * x + intercept);
+        sum += residual * residual;
+        ++count;
+    }
+    return sum / static_cast<double>(count);
+}
+
+int main()
+{
+    const std::size_t N = 2000000;
+    std::vector<DataPoint<double>> points;
+    points.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        double x = static_cast<double>(i);
+        points.push_back(DataPoint<double>(x, 3.0 * x + static_cast<double>((i * 7919) % 13) - 6.0));
+    }
+    DataSet<double> dataSet;
+    dataSet.addDataPoints(points.begin(), points.end());
+    dataSet.addModel(3.0, 0.0);
+
+    // Ventanas estrechas lejos del origen: dentro de un bloque y cruzando pocos bloques
+    const double narrow[][2] = {{N - 20.0, N - 1.0}, {1000000.0, 1000100.0}, {1999000.0, 1999999.0}};
+    for (const auto& window : narrow) {
+        LinearRegression<double> best = dataSet.findBestModelInRange("MSE", window[0], window[1]);
+        CHECK(nearlyEqual(best.getMSE(), directRangeMSE(dataSet, 3.0, 0.0, window[0], window[1]), 1e-9));
+    }
+
+    // En ventanas anchas la forma cerrada pierde del orden de ε·m²·Σ(x - x̄)² frente a Σr²
+    LinearRegression<double> wide = dataSet.findBestModelInRange("MSE", 1234567.0, 1299999.0);
+    CHECK(nearlyEqual(wide.getMSE(), directRangeMSE(dataSet, 3.0, 0.0, 1234567.0, 1299999.0), 1e-6));
+    dataSet.evaluateModelsClosedForm();
+    CHECK(nearlyEqual(dataSet.models().front().getMSE(), directRangeMSE(dataSet, 3.0, 0.0, 0.0, N - 1.0), 1e-4));
+    return testResult();
+}
@@ -0,0 +1,33 @@
+/*
+ * RangeQueryTest.cxx
+ * ----------------------
+ * Comprueba que una ventana de x sin puntos se rechaza igual con datos
+ * enteros (evaluación exacta) que con datos de punto flotante (forma cerrada).
+ */
+
+#include "DataSet.h"
+#include "TestCheck.h"
+#include <stdexcept>
+
+// Indica si findBestModelInRange rechaza la ventana [xLo, xHi] con std::runtime_error
+template <typename T>
+bool emptyRangeRejected(T xLo, T xHi)
+{
+    DataSet<T> dataSet;
+    for (int i = 0; i < 50; ++i)
+        dataSet.addDataPoint(static_cast<T>(i), static_cast<T>(2 * i));
+    dataSet.addModel(2.0, 0.0);
+    try {
+        dataSet.findBestModelInRange("MSE", xLo, xHi);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    CHECK(emptyRangeRejected<int>(100, 200));
+    CHECK(emptyRangeRejected<double>(100.0, 200.0));
+    return testResult();
+}
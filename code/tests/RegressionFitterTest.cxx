@@ -0,0 +1,109 @@
+/*
+ * RegressionFitterTest.cxx
+ * ----------------------
+ * Compara las rectas ajustadas con una búsqueda exhaustiva sobre conjuntos
+ * pequeños aleatorios: la de mínima desviación absoluta contra todas las
+ * rectas que pasan por dos puntos (y la horizontal en la mediana), y la de
+ * mínimos cuadrados contra la fórmula cerrada. La mitad de los conjuntos son
+ * enteros en un rango estrecho, con muchos x e y repetidos.
+ */
+
+#include "DataSet.h"
+#include "RegressionFitter.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+const int RANDOM_SETS = 1200;
+const std::size_t MAX_POINTS = 40;
+
+// Suma de |y - (intercept + slope·x)| con predicciones reales
+double absoluteDeviation(const std::vector<double>& xs, const std::vector<double>& ys, double slope, double intercept)
+{
+    double total = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        total += std::fabs(ys[i] - (xs[i] * slope + intercept));
+    return total;
+}
+
+// Menor desviación absoluta entre las rectas por dos puntos y la horizontal en la mediana
+double bruteForceDeviation(const std::vector<double>& xs, const std::vector<double>& ys)
+{
+    std::vector<double> sorted(ys);
+    std::sort(sorted.begin(), sorted.end());
+    double best = absoluteDeviation(xs, ys, 0.0, sorted[(sorted.size() - 1) / 2]);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+        for (std::size_t j = i + 1; j < xs.size(); ++j) {
+            if (xs[i] == xs[j])
+                continue;
+            double slope = (ys[j] - ys[i]) / (xs[j] - xs[i]);
+            best = std::min(best, absoluteDeviation(xs, ys, slope, ys[i] - slope * xs[i]));
+        }
+    return best;
+}
+
+// Error cuadrático medio de la recta de mínimos cuadrados por la fórmula cerrada
+double closedFormMeanSquaredError(const std::vector<double>& xs, const std::vector<double>& ys)
+{
+    const double n = static_cast<double>(xs.size());
+    double meanX = 0.0, meanY = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        meanX += xs[i] / n;
+        meanY += ys[i] / n;
+    }
+    double sxx = 0.0, sxy = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        sxx += (xs[i] - meanX) * (xs[i] - meanX);
+        sxy += (xs[i] - meanX) * (ys[i] - meanY);
+    }
+    double slope = sxx > 0.0 ? sxy / sxx : 0.0;
+    double intercept = meanY - slope * meanX;
+    double total = 0.0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        double residual = ys[i] - (xs[i] * slope + intercept);
+        total += residual * residual;
+    }
+    return total / n;
+}
+
+int main()
+{
+    std::mt19937 generator(20260417);
+    std::uniform_int_distribution<std::size_t> sizes(1, MAX_POINTS);
+    std::uniform_int_distribution<int> smallIntegers(-5, 5);
+    std::uniform_real_distribution<double> reals(-100.0, 100.0);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    for (int set = 0; set < RANDOM_SETS; ++set) {
+        const bool tieHeavy = set % 2 == 0;
+        const std::size_t n = sizes(generator);
+        const double slope = reals(generator) / 10.0;
+        const double intercept = reals(generator);
+        std::vector<double> xs(n), ys(n);
+        DataSet<double> dataSet;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (tieHeavy) {
+                xs[i] = smallIntegers(generator);
+                ys[i] = smallIntegers(generator) + std::round(xs[i] * slope);
+            } else {
+                xs[i] = reals(generator);
+                ys[i] = xs[i] * slope + intercept + noise(generator);
+            }
+            // Valores atípicos para que LAD y mínimos cuadrados difieran
+            if (unit(generator) < 0.15)
+                ys[i] += unit(generator) < 0.5 ? -50.0 : 50.0;
+            dataSet.addDataPoint(xs[i], ys[i]);
+        }
+
+        RegressionFitter<double> fitter;
+        LinearRegression<double> lad = fitter.fitLeastAbsoluteDeviations(dataSet);
+        LinearRegression<double> ols = fitter.fitLeastSquares(dataSet);
+        CHECK(nearlyEqual(lad.getMAE() * static_cast<double>(n), bruteForceDeviation(xs, ys), 1e-9));
+        CHECK(nearlyEqual(ols.getMSE(), closedFormMeanSquaredError(xs, ys), 1e-9));
+    }
+    return testResult();
+}
@@ -0,0 +1,41 @@
+/*
+ * SuccessiveHalvingTest.cxx
+ * ----------------------
+ * Comprueba que los finalistas de la eliminación sucesiva se evalúan igual
+ * con y sin grupo de hilos, y que el valor informado coincide bit a bit con
+ * el de evaluateModels.
+ */
+
+#include "DataSet.h"
+#include "TestCheck.h"
+#include "ThreadPool.h"
+#include <cmath>
+
+int main()
+{
+    DataSet<double> dataSet;
+    for (int i = 0; i < 50000; ++i) {
+        double x = (i * 7919 % 50000) / 100.0;
+        dataSet.addDataPoint(x, 2.0 * x + 1.0 + std::sin(0.37 * i) * 3.0);
+    }
+    // Modelos casi iguales: muchos sobreviven hasta la ronda final
+    for (int m = 0; m < 64; ++m)
+        dataSet.addModel(2.0 + (m % 8) * 1e-6, 1.0 + (m / 8) * 1e-4);
+    dataSet.evaluateModels();
+
+    HalvingOptions options;
+    ThreadPool pool(3);
+    const Metric metrics[] = {Metric::MAE, Metric::MSE, Metric::RMSE};
+    for (Metric metric : metrics) {
+        HalvingResult sequential = dataSet.findBestModelHalving(metricName(metric), options);
+        HalvingResult parallel = dataSet.findBestModelHalving(metricName(metric), options, &pool);
+        CHECK(sequential.finalists > 1);
+        CHECK(parallel.best == sequential.best);
+        CHECK(parallel.value == sequential.value);
+        const std::vector<double>& values = metric == Metric::MAE ? dataSet.modelBank.maeValues
+                                            : metric == Metric::MSE ? dataSet.modelBank.mseValues
+                                                                    : dataSet.modelBank.rmseValues;
+        CHECK(parallel.value == values[parallel.best]);
+    }
+    return testResult();
+}
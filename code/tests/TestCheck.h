@@ -0,0 +1,44 @@
+/*
+ * TestCheck.h
+ * ----------------------
+ * Utilidades mínimas para las pruebas: cada prueba es un ejecutable que
+ * registra sus fallos con CHECK y termina con testResult().
+ */
+
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cmath>
+#include <iostream>
+
+// Número de comprobaciones fallidas del ejecutable
+inline int& testFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+// Registra un fallo con el archivo y la línea si la condición es falsa
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falló " << #condition << std::endl; \
+            ++testFailures();                                                               \
+        }                                                                                   \
+    } while (0)
+
+// Compara dos valores con tolerancia relativa (y absoluta para valores cercanos a cero)
+inline bool nearlyEqual(double a, double b, double tolerance)
+{
+    return std::fabs(a - b) <= tolerance * std::fmax(1.0, std::fmax(std::fabs(a), std::fabs(b)));
+}
+
+// Código de salida para CTest: 0 si no hubo fallos
+inline int testResult()
+{
+    if (testFailures() != 0)
+        std::cerr << testFailures() << " comprobaciones fallidas" << std::endl;
+    return testFailures() == 0 ? 0 : 1;
+}
+
+#endif // TESTCHECK_H